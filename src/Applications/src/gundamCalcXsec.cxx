@@ -501,6 +501,7 @@ int main(int argc, char** argv){
       std::for_each(dataEvList.begin(), dataEvList.end(), []( Event& ev_){ ev_.getWeights().current = 0; });
     }
   }
+  propagator.getEventDialCache().requestFullReweight();
 
   bool enableEventMcThrow{true};
   bool enableStatThrowInToys{true};
@@ -580,6 +581,8 @@ int main(int argc, char** argv){
     for( auto& parSet : propagator.getParametersManager().getParameterSetsList() ){ parSet.moveParametersToPrior(); }
     propagator.propagateParameters();
     writeBinDataFct();
+    // event weights and histograms have been modified outside the propagator
+    propagator.getEventDialCache().requestFullReweight();
     xsecAtBestFitTree->Fill();
     GenericToolbox::writeInTFile( GenericToolbox::mkdirTFile(calcXsecDir, "throws"), xsecAtBestFitTree );
   }
@@ -612,6 +615,8 @@ int main(int argc, char** argv){
     }
 
     writeBinDataFct();
+    // event weights and histograms have been modified outside the propagator
+    propagator.getEventDialCache().requestFullReweight();
 
     // Write the branches
     xsecThrowTree->Fill();
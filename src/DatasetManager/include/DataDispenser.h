@@ -50,18 +50,46 @@ public:
 protected:
   void buildSampleToFillList();
   void parseStringParameters();
+  void buildEntryChunkList();
   void doEventSelection();
   void fetchRequestedLeaves();
   void preAllocateMemory();
   void readAndFill();
+  void compactLoadedEvents();
+  void mergeFillBuffers(std::vector<DataDispenserFillBuffer>& fillBufferList_);
+  void printSelectedEventCount();
   void loadFromHistContent();
 
   // utils
   std::unique_ptr<TChain> openChain(bool verbose_ = false);
+  int getNbFillThreads();
+  DataDispenserSelectionCuts defineSelectionCuts(GenericToolbox::LeafCollection& lCollection_, bool verbose_);
+  bool evalSelectionCuts(GenericToolbox::LeafCollection& lCollection_, const DataDispenserSelectionCuts& selectionCuts_,
+                         std::vector<bool>& isInSampleList_);
+
+  // fill
+  void initEntryReader(DataDispenserEntryReader& reader_, bool verbose_);
+  void initEventBuilder(DataDispenserEventBuilder& builder_, bool verbose_);
+  void initEntryBuffer(DataDispenserEntryBuffer& entry_, const DataDispenserEntryReader& reader_);
+  void printFillProgress(DataDispenserEntryReader& reader_, Long64_t iEntry_, int nReaderThreads_, int nThreads_);
+  DataDispenserFillBuffer* fetchFillBuffer(std::vector<DataDispenserFillBuffer>* fillBufferList_, size_t iChunk_);
+  /// false if the entry has no event to build. The event-by-event dials are
+  /// built from the branch objects here, so the events can be built after the
+  /// next GetEntry.
+  bool readEntry(DataDispenserEntryReader& reader_, Long64_t iEntry_, const DataDispenserCache::EntryChunk& chunk_,
+                 DataDispenserFillBuffer* fillBuffer_, DataDispenserEntryBuffer& entry_);
+  /// false once debugNbMaxEventsToLoad is reached
+  bool buildEvents(DataDispenserEventBuilder& builder_, DataDispenserEntryBuffer& entry_,
+                   DataDispenserCache::EntryChunk& chunk_, DataDispenserFillBuffer* fillBuffer_, bool verbose_);
+  void runFillPipeline(std::vector<DataDispenserFillBuffer>* fillBufferList_);
 
   // multi-thread
   void eventSelectionFunction(int iThread_);
-  void fillFunction(int iThread_);
+  /// fillBufferList_ is only set in single pass mode: one buffer per entry chunk
+  void fillFunction(int iThread_, std::vector<DataDispenserFillBuffer>* fillBufferList_ = nullptr);
+  void readerFunction(int iReader_, DataDispenserPipeline& pipeline_, std::vector<DataDispenserFillBuffer>* fillBufferList_);
+  void workerFunction(int iWorker_, DataDispenserPipeline& pipeline_, std::vector<DataDispenserFillBuffer>* fillBufferList_);
+  void mergeFillBuffer(DataDispenserFillBuffer& fillBuffer_);
 
 
 private:
@@ -9,11 +9,22 @@
 #include "EventVarTransformLib.h"
 
 #include "GenericToolbox.Wrappers.h"
+#include "GenericToolbox.Utils.h"
+#include "GenericToolbox.Root.h"
 
+#include "TChain.h"
+#include "TTreeFormula.h"
 #include "nlohmann/json.hpp"
 
 #include "string"
 #include "map"
+#include "deque"
+#include "mutex"
+#include "memory"
+#include "vector"
+#include "cstdint"
+#include "sstream"
+#include "condition_variable"
 
 
 struct DataDispenserParameters{
@@ -35,14 +46,31 @@ struct DataDispenserParameters{
   [[nodiscard]] std::string getSummary() const;
 };
 
+/// Event selection results: one bit per (entry, sample) pair, the bits of a
+/// given entry being contiguous. Each entry chunk starts on its own word, so
+/// different threads can fill different chunks without any merge.
+struct DataDispenserSelectionBitmap{
+  std::vector<uint64_t> wordList{};
+
+  void resize(size_t nBits_){ wordList.assign( (nBits_ + 63) / 64, 0 ); }
+  void clear(){ wordList = std::vector<uint64_t>(); }
+
+  void set(size_t iBit_){ wordList[iBit_ / 64] |= uint64_t(1) << (iBit_ % 64); }
+  [[nodiscard]] bool isSet(size_t iBit_) const { return (wordList[iBit_ / 64] >> (iBit_ % 64)) & uint64_t(1); }
+  [[nodiscard]] size_t getMemoryUsage() const { return wordList.size() * sizeof(uint64_t); }
+};
+
 struct DataDispenserCache{
   Propagator* propagatorPtr{nullptr};
 
+  bool isSinglePassLoading{false};
+  bool isPipelinedLoading{false};
   size_t totalNbEvents{0};
+  Event eventPlaceholder{};
 
   std::vector<Sample*> samplesToFillList{};
   std::vector<size_t> sampleNbOfEvents;
-  std::vector<std::vector<bool>> eventIsInSamplesList{};
+  DataDispenserSelectionBitmap selectionBitmap{};
   std::vector<size_t> sampleIndexOffsetList;
   std::vector< std::vector<Event>* > sampleEventListPtrToFill;
   std::vector<DialCollection*> dialCollectionsRefList{};
@@ -56,11 +84,36 @@ struct DataDispenserCache{
   // Variable transformations
   std::vector<EventVarTransformLib> eventVarTransformList;
 
-  struct ThreadSelectionResult{
-    std::vector<size_t> sampleNbOfEvents;
-    std::vector<std::vector<bool>> eventIsInSamplesList;
+  /// Entries of a TTree cluster, never across a file boundary, so that no
+  /// basket is decompressed by two threads. The slots of a chunk in the sample
+  /// containers and in the EventDialCache are assigned before the fill: the
+  /// threads don't share any index and the event order does not depend on the
+  /// scheduling.
+  struct EntryChunk{
+    Long64_t beginEntry{0};
+    Long64_t endEntry{0};
+    size_t firstSelectionBit{0}; // word aligned
+    std::vector<size_t> sampleNbOfEvents{}; // passing the cuts: number of slots
+    std::vector<size_t> sampleEventOffsetList{}; // first slot in the sample containers
+    EventDialCache::IndexedCacheEntry* cacheEntryPtr{nullptr};
+    size_t cacheEntryOffset{0};
+
+    // filled by the thread: some selected events get no bin or a null weight
+    std::vector<size_t> sampleNbOfLoadedEvents{};
+    size_t nLoadedCacheEntries{0};
+
+    [[nodiscard]] size_t getSelectionBit(Long64_t iEntry_, size_t iSample_, size_t nSamples_) const {
+      return firstSelectionBit + size_t(iEntry_ - beginEntry) * nSamples_ + iSample_;
+    }
   };
-  std::vector<ThreadSelectionResult> threadSelectionResults;
+  std::vector<EntryChunk> entryChunkList{};
+  GenericToolbox::Atomic<size_t> nextChunkIndex{0};
+
+  /// [first, last) chunks read in one go by a thread, pulled in order from a
+  /// shared queue. One chunk each, but in pipelined mode where the chunks of a
+  /// cluster are spread over the worker threads.
+  std::vector<std::pair<size_t, size_t>> readRangeList{};
+  GenericToolbox::Atomic<size_t> nextReadRangeIndex{0};
 
   void clear();
   void addVarRequestedForIndexing(const std::string& varName_);
@@ -68,6 +121,118 @@ struct DataDispenserCache{
 
 };
 
+/// Index of the selection cuts within a LeafCollection. -1 means no cut.
+struct DataDispenserSelectionCuts{
+  int globalCutIndex{-1};
+  std::vector<int> sampleCutIndexList{};
+};
+
+/// Events loaded by one thread in single pass mode. The final slots are only
+/// known once every thread is done: the events are moved to the sample
+/// containers afterwards. Not copyable, hence not part of DataDispenserCache.
+struct DataDispenserFillBuffer{
+  std::vector<size_t> sampleNbOfEvents{}; // passing the selection cuts
+  std::vector<std::vector<Event>> sampleEventList{};
+  std::vector<std::vector<EventDialCache::IndexedCacheEntry>> sampleCacheEntryList{};
+
+  // event-by-event dials are stored in their collection while merging
+  std::vector<std::unique_ptr<DialBase>> eventDialList{};
+  std::vector<size_t> collectionNbOfEventDials{};
+
+  // set before the merge
+  std::vector<size_t> sampleEventOffsetList{};
+  EventDialCache::IndexedCacheEntry* cacheEntryPtr{nullptr};
+};
+
+
+/// TChain side of the fill: owned by the thread reading the entries.
+struct DataDispenserEntryReader{
+  std::unique_ptr<TChain> treeChain{nullptr};
+  Long64_t nEntries{0};
+  GenericToolbox::LeafCollection lCollection{};
+  DataDispenserSelectionCuts selectionCuts{}; // single pass only
+
+  TTreeFormula* nominalWeightTreeFormula{nullptr};
+  TTreeFormula* dialIndexTreeFormula{nullptr};
+  std::vector<const GenericToolbox::LeafForm*> leafFormIndexingList{};
+  std::vector<const GenericToolbox::LeafForm*> leafFormStorageList{};
+  std::shared_ptr<std::vector<std::string>> indexingVarNameListPtr{nullptr};
+  std::shared_ptr<std::vector<std::string>> storageVarNameListPtr{nullptr};
+
+  // monitoring
+  GenericToolbox::VariableMonitor readSpeed{"bytes"};
+  std::stringstream ssProgressBar{};
+};
+
+/// What is needed from a TChain entry to build its events, so they can be
+/// built by another thread than the one that read it.
+struct DataDispenserEntryBuffer{
+  Long64_t iEntry{-1};
+  std::vector<bool> isInSampleList{};
+  Event indexingBuffer{}; // with the nominal weight
+  Event storageBuffer{};
+
+  // event-by-event dials, indexed by dial collection. Built by the reader as
+  // the TChain branch objects are overwritten by the next GetEntry.
+  std::vector<std::unique_ptr<DialBase>> dialBaseList{};
+};
+
+/// Event side of the fill: owned by the thread building the events.
+struct DataDispenserEventBuilder{
+  std::vector<EventVarTransformLib> eventVarTransformList{};
+  std::vector<EventVarTransformLib*> varTransformForIndexingList{};
+  std::vector<EventVarTransformLib*> varTransformForStorageList{};
+  Event eventIndexingBuffer{}; // the transforms are applied here
+};
+
+/// Bounded ring of entry batches between the reader threads and the worker
+/// threads of the pipelined loading. A batch holds the selected entries of one
+/// chunk, so the events of a chunk are built by a single worker. The batches
+/// are recycled: the entry buffers are only allocated once.
+struct DataDispenserPipeline{
+  struct Batch{
+    size_t chunkIndex{0};
+    size_t nEntries{0};
+    std::vector<DataDispenserEntryBuffer> entryList{};
+  };
+
+  /// Time the threads of a stage spent working and waiting for the other one
+  struct StageMonitor{
+    int nThreads{0};
+    double busyTime{0}; // s
+    double waitTime{0}; // s
+  };
+
+  std::vector<Batch> batchList{};
+  std::deque<Batch*> freeBatchList{};
+  std::deque<Batch*> filledBatchList{};
+  int nRunningReaders{0};
+  bool isAborted{false};
+
+  std::mutex mutex{};
+  std::condition_variable freeBatchCondition{};
+  std::condition_variable filledBatchCondition{};
+
+  StageMonitor readerMonitor{};
+  StageMonitor workerMonitor{};
+
+  void initialize(int nReaderThreads_, int nWorkerThreads_, size_t nBatches_, size_t batchSize_);
+
+  // reader side: blocks while all the batches are in use, nullptr if aborted
+  Batch* fetchFreeBatch();
+  void pushFilledBatch(Batch* batch_);
+  void stopReader(Batch* unusedBatch_, double busyTime_, double waitTime_);
+
+  // worker side: nullptr once every reader is done and the ring is empty
+  Batch* fetchFilledBatch();
+  void releaseBatch(Batch* batch_);
+  void stopWorker(double busyTime_, double waitTime_);
+
+  // a thread failed: the others must not wait for it
+  void abort();
+
+  void printUtilisation(double wallTime_) const;
+};
 
 
 #endif //GUNDAM_DATA_DISPENSER_UTILS_H
@@ -33,6 +33,12 @@ public:
 
   [[nodiscard]] bool isEnabled() const{ return _isEnabled_; }
   [[nodiscard]] bool isSortLoadedEvents() const{ return _sortLoadedEvents_; }
+  [[nodiscard]] bool isSinglePassLoading() const{ return _singlePassLoading_; }
+  [[nodiscard]] bool isPipelinedLoading() const{ return _pipelinedLoading_; }
+  [[nodiscard]] int getNbPipelineReaderThreads() const{ return _nPipelineReaderThreads_; }
+  [[nodiscard]] int getNbPipelineWorkerThreads() const{ return _nPipelineWorkerThreads_; }
+  [[nodiscard]] size_t getPipelineBufferSize() const{ return _pipelineBufferSize_; }
+  [[nodiscard]] size_t getPipelineBatchSize() const{ return _pipelineBatchSize_; }
   [[nodiscard]] bool isShowSelectedEventCount() const{ return _showSelectedEventCount_; }
   [[nodiscard]] bool isDevSingleThreadEventSelection() const{ return _devSingleThreadEventSelection_; }
   [[nodiscard]] bool isDevSingleThreadEventLoaderAndIndexer() const{ return _devSingleThreadEventLoaderAndIndexer_; }
@@ -58,6 +64,12 @@ private:
   std::string _selectedToyEntry_{"Asimov"};
 
   bool _sortLoadedEvents_{true}; // needed for reproducibility of toys in stat throw
+  bool _singlePassLoading_{false}; // selection evaluated while loading: each entry is read once
+  bool _pipelinedLoading_{false}; // reader threads feeding worker threads that build the events
+  int _nPipelineReaderThreads_{1};
+  int _nPipelineWorkerThreads_{0}; // 0: all the other threads
+  size_t _pipelineBufferSize_{0}; // in batches, 0: 4 per worker thread
+  size_t _pipelineBatchSize_{1000}; // in entries
   bool _devSingleThreadEventLoaderAndIndexer_{false};
   bool _devSingleThreadEventSelection_{false};
 
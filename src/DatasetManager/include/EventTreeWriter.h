@@ -44,6 +44,7 @@ private:
 
   // cache
   mutable const Propagator* propagatorPtr{nullptr};
+  mutable const SampleElement* sampleElementPtr{nullptr}; // holds the binned normalisations of the written events
 
 };
 
@@ -27,7 +27,9 @@
 
 #include <string>
 #include <vector>
+#include <chrono>
 #include <sstream>
+#include <algorithm>
 
 LoggerInit([]{
   Logger::setUserHeaderStr("[DataDispenser]");
@@ -100,8 +102,25 @@ void DataDispenser::load(Propagator& propagator_){
     LogThrowIf(not GenericToolbox::doesTFileIsValid(path, {_parameters_.treePath}), "Invalid file: " << path);
   }
 
+  _cache_.isSinglePassLoading = _owner_->isSinglePassLoading();
+  if( _cache_.isSinglePassLoading and _parameters_.debugNbMaxEventsToLoad != 0 ){
+    LogAlert << "debugNbMaxEventsToLoad is set: selecting the events in a separate pass." << std::endl;
+    _cache_.isSinglePassLoading = false;
+  }
+
+  _cache_.isPipelinedLoading = _owner_->isPipelinedLoading();
+  if( _cache_.isPipelinedLoading and _parameters_.debugNbMaxEventsToLoad != 0 ){
+    LogAlert << "debugNbMaxEventsToLoad is set: pipelined loading disabled." << std::endl;
+    _cache_.isPipelinedLoading = false;
+  }
+  if( _cache_.isPipelinedLoading and this->getNbFillThreads() < 2 ){
+    LogAlert << "Pipelined loading needs at least two threads: disabled." << std::endl;
+    _cache_.isPipelinedLoading = false;
+  }
+
   this->parseStringParameters();
-  this->doEventSelection();
+  this->buildEntryChunkList();
+  if( not _cache_.isSinglePassLoading ){ this->doEventSelection(); }
   this->fetchRequestedLeaves();
   this->preAllocateMemory();
   this->readAndFill();
@@ -194,6 +213,74 @@ void DataDispenser::parseStringParameters() {
   if(not _parameters_.nominalWeightFormulaStr.empty()){ _parameters_.nominalWeightFormulaStr = "(" + _parameters_.nominalWeightFormulaStr + ")"; }
   if(not _parameters_.selectionCutFormulaStr.empty()){ _parameters_.selectionCutFormulaStr = "(" + _parameters_.selectionCutFormulaStr + ")"; }
 }
+void DataDispenser::buildEntryChunkList(){
+  LogInfo << "Partitioning the entries on the TTree clusters..." << std::endl;
+
+  auto treeChain{this->openChain(true)};
+  Long64_t nEntries{treeChain->GetEntries()}; // also fills the tree offsets
+  LogThrowIf(nEntries == 0, "TChain is empty.");
+  LogInfo << "Will read " << nEntries << " event entries." << std::endl;
+
+  // clusters of the whole chain, as [begin, end) chain entries
+  std::vector<std::pair<Long64_t, Long64_t>> clusterList{};
+  for( int iTree = 0 ; iTree < treeChain->GetNtrees() ; iTree++ ){
+    Long64_t treeOffset{treeChain->GetTreeOffset()[iTree]};
+    if( treeOffset >= nEntries ){ break; }
+
+    treeChain->LoadTree( treeOffset );
+    if( treeChain->GetTreeNumber() != iTree ){ continue; } // empty file: the next one got loaded
+
+    auto* tree = treeChain->GetTree();
+    Long64_t nTreeEntries{tree->GetEntries()};
+    Long64_t clusterBegin;
+    auto clusterIterator = tree->GetClusterIterator(0);
+    while( (clusterBegin = clusterIterator()) < nTreeEntries ){
+      clusterList.emplace_back( treeOffset + clusterBegin, treeOffset + std::min( clusterIterator.GetNextEntry(), nTreeEntries ) );
+    }
+  }
+
+  // a cluster is read at once. Only if there are not enough of them to keep
+  // every thread busy (typically files written without auto-flush), they
+  // are split in several reads decompressing the same baskets.
+  int nThreads{GundamGlobals::getParallelWorker().getNbThreads()};
+  Long64_t maxReadSize{nEntries};
+  if( Long64_t(clusterList.size()) < nThreads ){
+    maxReadSize = std::max( Long64_t(1), nEntries / (4 * Long64_t(nThreads)) );
+    LogAlert << "Only " << clusterList.size() << " TTree cluster(s) for " << nThreads
+             << " threads: splitting them in reads of " << maxReadSize << " entries." << std::endl;
+  }
+
+  // pipelined: the chunks read by a reader are spread over the workers
+  Long64_t maxChunkSize{maxReadSize};
+  if( _cache_.isPipelinedLoading ){ maxChunkSize = std::min( maxChunkSize, Long64_t(_owner_->getPipelineBatchSize()) ); }
+
+  size_t nSamples{_cache_.samplesToFillList.size()};
+  size_t nextSelectionBit{0};
+  for( auto& cluster : clusterList ){
+    for( Long64_t readBegin = cluster.first ; readBegin < cluster.second ; readBegin += maxReadSize ){
+      Long64_t readEnd{std::min( cluster.second, readBegin + maxReadSize )};
+      _cache_.readRangeList.emplace_back( _cache_.entryChunkList.size(), 0 );
+      for( Long64_t chunkBegin = readBegin ; chunkBegin < readEnd ; chunkBegin += maxChunkSize ){
+        _cache_.entryChunkList.emplace_back();
+        auto& chunk = _cache_.entryChunkList.back();
+        chunk.beginEntry = chunkBegin;
+        chunk.endEntry = std::min( readEnd, chunkBegin + maxChunkSize );
+        chunk.sampleNbOfEvents.resize(nSamples, 0);
+
+        // word aligned: the threads never write the same word of the selection bitmap
+        chunk.firstSelectionBit = (nextSelectionBit + 63) / 64 * 64;
+        nextSelectionBit = chunk.getSelectionBit(chunk.endEntry, 0, nSamples);
+      }
+      _cache_.readRangeList.back().second = _cache_.entryChunkList.size();
+    }
+  }
+
+  LogThrowIf(_cache_.entryChunkList.empty() or _cache_.entryChunkList.back().endEntry != nEntries,
+             "Could not partition the " << nEntries << " entries of the TChain on its clusters.");
+  LogInfo << "Entries split in " << _cache_.readRangeList.size() << " read ranges of "
+          << _cache_.entryChunkList.size() << " chunks over " << clusterList.size() << " clusters and "
+          << treeChain->GetNtrees() << " files." << std::endl;
+}
 void DataDispenser::doEventSelection(){
   LogWarning << "Performing event selection..." << std::endl;
 
@@ -202,24 +289,13 @@ void DataDispenser::doEventSelection(){
   // Could lead to weird behaviour of ROOT object otherwise:
   ROOT::EnableThreadSafety();
 
-  // how meaning buffers?
-  int nThreads{GundamGlobals::getParallelWorker().getNbThreads()};
-  if( _owner_->isDevSingleThreadEventSelection() ) { nThreads = 1; }
-
-  Long64_t nEntries{0};
-  {
-    auto treeChain{this->openChain(true)};
-    nEntries = treeChain->GetEntries();
-  }
-  LogThrowIf(nEntries == 0, "TChain is empty.");
-  LogInfo << "Will read " << nEntries << " event entries." << std::endl;
-
-  _cache_.threadSelectionResults.resize(nThreads);
-  for( auto& threadResults : _cache_.threadSelectionResults ){
-    threadResults.sampleNbOfEvents.resize(_cache_.samplesToFillList.size(), 0);
-    threadResults.eventIsInSamplesList.resize(nEntries, std::vector<bool>(_cache_.samplesToFillList.size(), false));
-  }
+  // shared by the threads: each chunk has its own words
+  size_t nSamples{_cache_.samplesToFillList.size()};
+  auto& lastChunk = _cache_.entryChunkList.back();
+  _cache_.selectionBitmap.resize( lastChunk.getSelectionBit(lastChunk.endEntry, 0, nSamples) );
+  LogInfo << "Selection bitmap: " << GenericToolbox::parseSizeUnits(double(_cache_.selectionBitmap.getMemoryUsage())) << std::endl;
 
+  _cache_.nextReadRangeIndex.setValue(0);
   if( not _owner_->isDevSingleThreadEventSelection() ) {
     GundamGlobals::getParallelWorker().addJob(__METHOD_NAME__, [this](int iThread_){ this->eventSelectionFunction(iThread_); });
     GundamGlobals::getParallelWorker().runJob(__METHOD_NAME__);
@@ -229,45 +305,20 @@ void DataDispenser::doEventSelection(){
     this->eventSelectionFunction(-1);
   }
 
-  LogInfo << "Merging thread results..." << std::endl;
-  _cache_.sampleNbOfEvents.resize(_cache_.samplesToFillList.size(), 0);
-  _cache_.eventIsInSamplesList.resize(nEntries, std::vector<bool>(_cache_.samplesToFillList.size(), false));
-  for( auto& threadResults : _cache_.threadSelectionResults ){
-    // merging nEvents
-
-    for( int iSample = 0 ; iSample < int(_cache_.sampleNbOfEvents.size()) ; iSample++ ){
-      _cache_.sampleNbOfEvents[iSample] += threadResults.sampleNbOfEvents[iSample];
+  LogInfo << "Merging chunk results..." << std::endl;
+  _cache_.sampleNbOfEvents.resize(nSamples, 0);
+  for( auto& chunk : _cache_.entryChunkList ){
+    // the selection bits are already in place: only the counts are merged
+    for( size_t iSample = 0 ; iSample < nSamples ; iSample++ ){
+      _cache_.sampleNbOfEvents[iSample] += chunk.sampleNbOfEvents[iSample];
     }
-
-    for( size_t iEntry = 0 ; iEntry < int(_cache_.eventIsInSamplesList.size()) ; iEntry++ ){
-      for( size_t iSample = 0 ; iSample < int(_cache_.eventIsInSamplesList[iEntry].size()) ; iSample++ ){
-        if( threadResults.eventIsInSamplesList[iEntry][iSample] ){
-          _cache_.eventIsInSamplesList[iEntry][iSample] = true;
-        }
-      }
-    }
-
   }
 
-  LogInfo << "Freeing up thread buffers..." << std::endl;
-  _cache_.threadSelectionResults.clear();
-
-
   for(size_t iSample = 0 ; iSample < _cache_.samplesToFillList.size() ; iSample++ ){
     _cache_.totalNbEvents += _cache_.sampleNbOfEvents[iSample];
   }
 
-  if( _owner_->isShowSelectedEventCount() ){
-    LogWarning << "Events passing selection cuts:" << std::endl;
-    GenericToolbox::TablePrinter t;
-    t.setColTitles({{"Sample"}, {"# of events"}});
-    for(size_t iSample = 0 ; iSample < _cache_.samplesToFillList.size() ; iSample++ ){
-      t.addTableLine({_cache_.samplesToFillList[iSample]->getName(), std::to_string(_cache_.sampleNbOfEvents[iSample])});
-    }
-    t.addTableLine({"Total", std::to_string(_cache_.totalNbEvents)});
-    t.printTable();
-  }
-
+  this->printSelectedEventCount();
 }
 void DataDispenser::fetchRequestedLeaves(){
   LogWarning << "Poll every objects for requested variables..." << std::endl;
@@ -413,7 +464,7 @@ void DataDispenser::preAllocateMemory(){
   }
   lCollection.initialize();
 
-  Event eventPlaceholder;
+  auto& eventPlaceholder{_cache_.eventPlaceholder};
   eventPlaceholder.getIndices().dataset = _owner_->getDataSetIndex();
   eventPlaceholder.getVariables().setVarNameList( std::make_shared<std::vector<std::string>>(_cache_.varsRequestedForStorage) );
 
@@ -430,12 +481,15 @@ void DataDispenser::preAllocateMemory(){
   LogInfo << "Reserving event memory..." << std::endl;
   _cache_.sampleIndexOffsetList.resize(_cache_.samplesToFillList.size());
   _cache_.sampleEventListPtrToFill.resize(_cache_.samplesToFillList.size());
-  for( size_t iSample = 0 ; iSample < _cache_.sampleNbOfEvents.size() ; iSample++ ){
+  for( size_t iSample = 0 ; iSample < _cache_.samplesToFillList.size() ; iSample++ ){
     auto* container = &_cache_.samplesToFillList[iSample]->getDataContainer();
     if(_parameters_.useMcContainer) container = &_cache_.samplesToFillList[iSample]->getMcContainer();
 
     _cache_.sampleEventListPtrToFill[iSample] = &container->getEventList();
     _cache_.sampleIndexOffsetList[iSample] = _cache_.sampleEventListPtrToFill[iSample]->size();
+
+    // single pass: reserved once the events are loaded
+    if( _cache_.isSinglePassLoading ){ continue; }
     container->reserveEventMemory(_owner_->getDataSetIndex(), _cache_.sampleNbOfEvents[iSample], eventPlaceholder);
   }
 
@@ -464,6 +518,9 @@ void DataDispenser::preAllocateMemory(){
           }
         }
         else if( not dialCollection->getGlobalDialLeafName().empty() ){
+          // single pass: the slots are created when merging the thread buffers
+          if( _cache_.isSinglePassLoading ){ continue; }
+
           // Reserve memory for additional dials (those on a tree leaf)
           auto dialType = dialCollection->getGlobalDialType();
           LogInfo << dialCollection->getTitle() << ": creating " << _cache_.totalNbEvents;
@@ -479,15 +536,39 @@ void DataDispenser::preAllocateMemory(){
         }
       }
 
-      LogInfo << "Creating " << _cache_.totalNbEvents << " event cache slots." << std::endl;
-      _cache_.propagatorPtr->getEventDialCache().allocateCacheEntries(_cache_.totalNbEvents, nDialsMaxPerEvent);
+      if( not _cache_.isSinglePassLoading ){
+        LogInfo << "Creating " << _cache_.totalNbEvents << " event cache slots." << std::endl;
+        _cache_.propagatorPtr->getEventDialCache().allocateCacheEntries(_cache_.totalNbEvents, nDialsMaxPerEvent);
+      }
     }
-    else{
+    else if( not _cache_.isSinglePassLoading ){
       // all events should be referenced in the cache even with 0 dial
       LogInfo << "Creating " << _cache_.totalNbEvents << " event cache slots (dial-less)." << std::endl;
       _cache_.propagatorPtr->getEventDialCache().allocateCacheEntries(_cache_.totalNbEvents, 0);
     }
   }
+
+  if( _cache_.isSinglePassLoading ){ return; }
+
+  LogInfo << "Assigning the event slots of each entry chunk..." << std::endl;
+  // prefix sums of the selected events: each chunk gets its own ranges
+  std::vector<size_t> sampleSlotList{_cache_.sampleIndexOffsetList};
+  EventDialCache::IndexedCacheEntry* cacheEntryPtr{nullptr};
+  if( _parameters_.useMcContainer ){
+    cacheEntryPtr = _cache_.propagatorPtr->getEventDialCache().fetchNextCacheEntries(_cache_.totalNbEvents);
+  }
+  size_t cacheEntryOffset{0};
+  for( auto& chunk : _cache_.entryChunkList ){
+    chunk.sampleEventOffsetList = sampleSlotList;
+    chunk.sampleNbOfLoadedEvents.assign(sampleSlotList.size(), 0);
+    chunk.nLoadedCacheEntries = 0;
+    chunk.cacheEntryOffset = cacheEntryOffset;
+    if( cacheEntryPtr != nullptr ){ chunk.cacheEntryPtr = cacheEntryPtr + cacheEntryOffset; }
+    for( size_t iSample = 0 ; iSample < sampleSlotList.size() ; iSample++ ){
+      sampleSlotList[iSample] += chunk.sampleNbOfEvents[iSample];
+      cacheEntryOffset += chunk.sampleNbOfEvents[iSample];
+    }
+  }
 }
 void DataDispenser::readAndFill(){
   LogWarning << "Reading dataset and loading..." << std::endl;
@@ -499,17 +580,41 @@ void DataDispenser::readAndFill(){
     LogInfo << "Dial index for TClonesArray: \"" << _parameters_.dialIndexFormula << "\"" << std::endl;
   }
 
+  bool isMultiThread{this->getNbFillThreads() > 1};
+
+  // single pass: each chunk keeps its events until all of them are done
+  std::vector<DataDispenserFillBuffer> fillBufferList{};
+  if( _cache_.isSinglePassLoading ){
+    LogInfo << "Selection cuts are evaluated while loading: each entry is read once." << std::endl;
+    fillBufferList.resize( _cache_.entryChunkList.size() );
+  }
+  auto* fillBufferListPtr = _cache_.isSinglePassLoading ? &fillBufferList : nullptr;
+
   LogWarning << "Loading and indexing..." << std::endl;
-  if(not _owner_->isDevSingleThreadEventLoaderAndIndexer() and GundamGlobals::getParallelWorker().getNbThreads() > 1 ){
+  _cache_.nextReadRangeIndex.setValue(0);
+  if( _cache_.isPipelinedLoading ){
     ROOT::EnableThreadSafety(); // EXTREMELY IMPORTANT
-    GundamGlobals::getParallelWorker().addJob(__METHOD_NAME__, [&](int iThread_){ this->fillFunction(iThread_); });
+    this->runFillPipeline(fillBufferListPtr);
+  }
+  else if( isMultiThread ){
+    ROOT::EnableThreadSafety(); // EXTREMELY IMPORTANT
+    GundamGlobals::getParallelWorker().addJob(__METHOD_NAME__, [&](int iThread_){ this->fillFunction(iThread_, fillBufferListPtr); });
     GundamGlobals::getParallelWorker().runJob(__METHOD_NAME__);
     GundamGlobals::getParallelWorker().removeJob(__METHOD_NAME__);
   }
   else{
-    this->fillFunction(-1); // for better debug breakdown
+    this->fillFunction(-1, fillBufferListPtr); // for better debug breakdown
+  }
+
+  if( _cache_.isSinglePassLoading ){
+    // containers are created with the exact size: nothing to shrink
+    this->mergeFillBuffers( fillBufferList );
+    return;
   }
 
+  _cache_.selectionBitmap.clear();
+  this->compactLoadedEvents();
+
   LogInfo << "Shrinking lists..." << std::endl;
   for( size_t iSample = 0 ; iSample < _cache_.samplesToFillList.size() ; iSample++ ){
     auto* container = &_cache_.samplesToFillList[iSample]->getDataContainer();
@@ -518,6 +623,133 @@ void DataDispenser::readAndFill(){
   }
 
 }
+void DataDispenser::compactLoadedEvents(){
+  // the slots of the selected events that got no bin or a null weight are
+  // left empty at the end of each chunk
+  LogInfo << "Compacting the loaded events..." << std::endl;
+
+  size_t nSamples{_cache_.samplesToFillList.size()};
+  std::vector<size_t> sampleIndexList(nSamples);
+  for( size_t iSample = 0 ; iSample < nSamples ; iSample++ ){ sampleIndexList[iSample] = size_t(_cache_.samplesToFillList[iSample]->getIndex()); }
+
+  std::vector<size_t> sampleNextSlotList{};
+  std::vector<size_t> sampleShiftList(nSamples, 0);
+  for( auto& chunk : _cache_.entryChunkList ){
+    if( sampleNextSlotList.empty() ){ sampleNextSlotList = chunk.sampleEventOffsetList; }
+
+    bool hasShift{false};
+    for( size_t iSample = 0 ; iSample < nSamples ; iSample++ ){
+      auto& eventList = *_cache_.sampleEventListPtrToFill[iSample];
+      size_t beginSlot{chunk.sampleEventOffsetList[iSample]};
+      size_t nEvents{chunk.sampleNbOfLoadedEvents[iSample]};
+
+      // moving down, in chunk order: never overwrites an event to be moved
+      sampleShiftList[iSample] = beginSlot - sampleNextSlotList[iSample];
+      if( sampleShiftList[iSample] != 0 ){
+        hasShift = true;
+        std::move(eventList.begin() + long(beginSlot), eventList.begin() + long(beginSlot + nEvents),
+                  eventList.begin() + long(sampleNextSlotList[iSample]));
+      }
+      sampleNextSlotList[iSample] += nEvents;
+    }
+
+    if( not hasShift or chunk.cacheEntryPtr == nullptr ){ continue; }
+    for( size_t iEntry = 0 ; iEntry < chunk.nLoadedCacheEntries ; iEntry++ ){
+      auto& cacheEntry = chunk.cacheEntryPtr[iEntry];
+      size_t iSample{size_t(std::find(sampleIndexList.begin(), sampleIndexList.end(), cacheEntry.event.sampleIndex) - sampleIndexList.begin())};
+      cacheEntry.event.eventIndex -= sampleShiftList[iSample];
+    }
+  }
+
+  // the containers are shrunk to this size
+  if( not sampleNextSlotList.empty() ){ _cache_.sampleIndexOffsetList = sampleNextSlotList; }
+}
+void DataDispenser::mergeFillBuffers(std::vector<DataDispenserFillBuffer>& fillBufferList_){
+  LogInfo << "Merging the events loaded for each chunk..." << std::endl;
+
+  auto& dialCollectionList = _cache_.propagatorPtr->getDialCollectionList();
+  size_t nSamples{_cache_.samplesToFillList.size()};
+
+  // one buffer per chunk: appending them in order keeps the events sorted by
+  // entry, whichever thread read them
+  std::vector<size_t> sampleNbOfLoadedEvents(nSamples, 0);
+  std::vector<size_t> collectionNbOfEventDials(dialCollectionList.size(), 0);
+  size_t nCacheEntries{0};
+  _cache_.sampleNbOfEvents.assign(nSamples, 0);
+  for( auto& fillBuffer : fillBufferList_ ){
+    fillBuffer.sampleEventOffsetList.resize(nSamples, 0);
+    for( size_t iSample = 0 ; iSample < nSamples ; iSample++ ){
+      _cache_.sampleNbOfEvents[iSample] += fillBuffer.sampleNbOfEvents[iSample];
+      fillBuffer.sampleEventOffsetList[iSample] = _cache_.sampleIndexOffsetList[iSample] + sampleNbOfLoadedEvents[iSample];
+      sampleNbOfLoadedEvents[iSample] += fillBuffer.sampleEventList[iSample].size();
+      nCacheEntries += fillBuffer.sampleCacheEntryList[iSample].size();
+    }
+    for( size_t iCollection = 0 ; iCollection < collectionNbOfEventDials.size() ; iCollection++ ){
+      collectionNbOfEventDials[iCollection] += fillBuffer.collectionNbOfEventDials[iCollection];
+    }
+  }
+
+  _cache_.totalNbEvents = 0;
+  for( size_t iSample = 0 ; iSample < nSamples ; iSample++ ){ _cache_.totalNbEvents += _cache_.sampleNbOfEvents[iSample]; }
+  this->printSelectedEventCount();
+
+  LogInfo << "Reserving event memory..." << std::endl;
+  for( size_t iSample = 0 ; iSample < nSamples ; iSample++ ){
+    auto* container = &_cache_.samplesToFillList[iSample]->getDataContainer();
+    if(_parameters_.useMcContainer) container = &_cache_.samplesToFillList[iSample]->getMcContainer();
+    container->reserveEventMemory(_owner_->getDataSetIndex(), sampleNbOfLoadedEvents[iSample], _cache_.eventPlaceholder);
+    _cache_.sampleIndexOffsetList[iSample] += sampleNbOfLoadedEvents[iSample];
+  }
+
+  if( _parameters_.useMcContainer ){
+    for( auto* dialCollection : _cache_.dialCollectionsRefList ){
+      if( dialCollection->isBinned() ){ continue; }
+      LogScopeIndent;
+      LogInfo << dialCollection->getTitle() << ": creating " << collectionNbOfEventDials[dialCollection->getIndex()];
+      LogInfo << " slots for " << dialCollection->getGlobalDialType() << std::endl;
+      dialCollection->getDialBaseList().resize(
+          dialCollection->getDialBaseList().size()
+          + collectionNbOfEventDials[dialCollection->getIndex()]
+      );
+    }
+
+    // the dial lists are moved from the buffers: no need to allocate them
+    LogInfo << "Creating " << nCacheEntries << " event cache slots." << std::endl;
+    _cache_.propagatorPtr->getEventDialCache().allocateCacheEntries(nCacheEntries, 0);
+    auto* cacheEntryPtr = _cache_.propagatorPtr->getEventDialCache().fetchNextCacheEntries(nCacheEntries);
+    for( auto& fillBuffer : fillBufferList_ ){
+      fillBuffer.cacheEntryPtr = cacheEntryPtr;
+      for( auto& cacheEntryList : fillBuffer.sampleCacheEntryList ){ cacheEntryPtr += cacheEntryList.size(); }
+    }
+  }
+
+  // the buffers are independent: the threads pull them from the chunk queue
+  if( this->getNbFillThreads() > 1 ){
+    _cache_.nextChunkIndex.setValue(0);
+    GundamGlobals::getParallelWorker().addJob(__METHOD_NAME__, [&](int){
+      for( size_t iChunk = _cache_.nextChunkIndex++ ; iChunk < fillBufferList_.size() ; iChunk = _cache_.nextChunkIndex++ ){
+        this->mergeFillBuffer(fillBufferList_[iChunk]);
+      }
+    });
+    GundamGlobals::getParallelWorker().runJob(__METHOD_NAME__);
+    GundamGlobals::getParallelWorker().removeJob(__METHOD_NAME__);
+  }
+  else{
+    for( auto& fillBuffer : fillBufferList_ ){ this->mergeFillBuffer(fillBuffer); }
+  }
+}
+void DataDispenser::printSelectedEventCount(){
+  if( not _owner_->isShowSelectedEventCount() ){ return; }
+
+  LogWarning << "Events passing selection cuts:" << std::endl;
+  GenericToolbox::TablePrinter t;
+  t.setColTitles({{"Sample"}, {"# of events"}});
+  for(size_t iSample = 0 ; iSample < _cache_.samplesToFillList.size() ; iSample++ ){
+    t.addTableLine({_cache_.samplesToFillList[iSample]->getName(), std::to_string(_cache_.sampleNbOfEvents[iSample])});
+  }
+  t.addTableLine({"Total", std::to_string(_cache_.totalNbEvents)});
+  t.printTable();
+}
 void DataDispenser::loadFromHistContent(){
   LogWarning << "Creating dummy PhysicsEvent entries for loading hist content" << std::endl;
 
@@ -633,42 +865,28 @@ std::unique_ptr<TChain> DataDispenser::openChain(bool verbose_){
 
   return treeChain;
 }
+int DataDispenser::getNbFillThreads(){
+  if( _owner_->isDevSingleThreadEventLoaderAndIndexer() ){ return 1; }
+  return GundamGlobals::getParallelWorker().getNbThreads();
+}
+DataDispenserSelectionCuts DataDispenser::defineSelectionCuts(GenericToolbox::LeafCollection& lCollection_, bool verbose_){
+  LogInfoIf(verbose_) << "Defining selection formulas..." << std::endl;
 
-void DataDispenser::eventSelectionFunction(int iThread_){
-
-  int nThreads{GundamGlobals::getParallelWorker().getNbThreads()};
-  if( iThread_ == -1 ){ iThread_ = 0; nThreads = 1; }
-
-  // Opening ROOT file...
-  auto treeChain{this->openChain(false)};
-
-  GenericToolbox::LeafCollection lCollection;
-  lCollection.setTreePtr( treeChain.get() );
-
-  LogInfoIf(iThread_ == 0) << "Defining selection formulas..." << std::endl;
+  DataDispenserSelectionCuts out{};
 
   // global cut
-  int selectionCutLeafFormIndex{-1};
   if( not _parameters_.selectionCutFormulaStr.empty() ){
-    LogInfoIf(iThread_ == 0) << "Global selection cut: \"" << _parameters_.selectionCutFormulaStr << "\"" << std::endl;
-    selectionCutLeafFormIndex = lCollection.addLeafExpression( _parameters_.selectionCutFormulaStr );
+    LogInfoIf(verbose_) << "Global selection cut: \"" << _parameters_.selectionCutFormulaStr << "\"" << std::endl;
+    out.globalCutIndex = lCollection_.addLeafExpression( _parameters_.selectionCutFormulaStr );
   }
 
   // sample cuts
   GenericToolbox::TablePrinter tableSelectionCuts;
   tableSelectionCuts.setColTitles({{"Sample"}, {"Selection Cut"}});
 
-  struct SampleCut{
-    int sampleIndex{-1};
-    int cutIndex{-1};
-  };
-  std::vector<SampleCut> sampleCutList;
-  sampleCutList.reserve( _cache_.samplesToFillList.size() );
-
-  for( int iSample = 0; iSample < int(_cache_.samplesToFillList.size()) ; iSample++ ){
-    auto* samplePtr = _cache_.samplesToFillList[iSample];
-    sampleCutList.emplace_back();
-    sampleCutList.back().sampleIndex = iSample;
+  out.sampleCutIndexList.reserve( _cache_.samplesToFillList.size() );
+  for( auto* samplePtr : _cache_.samplesToFillList ){
+    out.sampleCutIndexList.emplace_back(-1);
 
     std::string selectionCut = samplePtr->getSelectionCutsStr();
     for (auto &replaceEntry: _cache_.varsToOverrideList) {
@@ -679,202 +897,191 @@ void DataDispenser::eventSelectionFunction(int iThread_){
 
     if( selectionCut.empty() ){ continue; }
 
-    sampleCutList.back().cutIndex = lCollection.addLeafExpression( selectionCut );
+    out.sampleCutIndexList.back() = lCollection_.addLeafExpression( selectionCut );
     tableSelectionCuts << samplePtr->getName() << GenericToolbox::TablePrinter::Action::NextColumn;
     tableSelectionCuts << selectionCut << GenericToolbox::TablePrinter::Action::NextLine;
+  }
+  if( verbose_ ){ tableSelectionCuts.printTable(); }
 
+  return out;
+}
+bool DataDispenser::evalSelectionCuts(GenericToolbox::LeafCollection& lCollection_, const DataDispenserSelectionCuts& selectionCuts_,
+                                      std::vector<bool>& isInSampleList_){
+  bool hasSample{false};
+  std::fill( isInSampleList_.begin(), isInSampleList_.end(), false );
+
+  if( selectionCuts_.globalCutIndex != -1
+      and lCollection_.getLeafFormList()[selectionCuts_.globalCutIndex].evalAsDouble() == 0 ){
+    return false;
+  }
+
+  for( size_t iSample = 0 ; iSample < selectionCuts_.sampleCutIndexList.size() ; iSample++ ){
+    int cutIndex{selectionCuts_.sampleCutIndexList[iSample]};
+    if( cutIndex != -1 and lCollection_.getLeafFormList()[cutIndex].evalAsDouble() == 0 ){ continue; }
+    isInSampleList_[iSample] = true;
+    hasSample = true;
   }
-  if( iThread_==0 ){ tableSelectionCuts.printTable(); }
+  return hasSample;
+}
+
+void DataDispenser::eventSelectionFunction(int iThread_){
+
+  int nThreads{GundamGlobals::getParallelWorker().getNbThreads()};
+  if( iThread_ == -1 ){ iThread_ = 0; nThreads = 1; }
+
+  // Opening ROOT file...
+  auto treeChain{this->openChain(false)};
+
+  GenericToolbox::LeafCollection lCollection;
+  lCollection.setTreePtr( treeChain.get() );
+
+  auto selectionCuts{this->defineSelectionCuts(lCollection, iThread_ == 0)};
 
   lCollection.initialize();
 
   GenericToolbox::VariableMonitor readSpeed("bytes");
 
-  // Multi-thread index splitting
   Long64_t nEvents = treeChain->GetEntries();
-  Long64_t iGlobal = 0;
-
-  auto bounds = GenericToolbox::ParallelWorker::getThreadBoundIndices( iThread_, nThreads, nEvents );
-
-  // Load the branches
-  treeChain->LoadTree( bounds.beginIndex );
+  size_t nSamples{_cache_.samplesToFillList.size()};
 
   // for each event, which sample is active?
   std::string progressTitle = "Performing event selection on " + this->getTitle() + "...";
   std::stringstream ssProgressTitle;
-  TFile *lastFilePtr{nullptr};
 
-  for ( Long64_t iEntry = bounds.beginIndex ; iEntry < bounds.endIndex ; iEntry++ ) {
-    if( iThread_ == 0 ){
-      readSpeed.addQuantity(treeChain->GetEntry(iEntry)*nThreads);
-      if (GenericToolbox::showProgressBar(iGlobal, nEvents)) {
-        ssProgressTitle.str("");
+  // the read ranges are pulled in entry order: the one of thread 0 tracks the progress
+  for( size_t iRange = _cache_.nextReadRangeIndex++ ; iRange < _cache_.readRangeList.size() ; iRange = _cache_.nextReadRangeIndex++ ){
+    for( size_t iChunk = _cache_.readRangeList[iRange].first ; iChunk < _cache_.readRangeList[iRange].second ; iChunk++ ){
+      auto& chunk = _cache_.entryChunkList[iChunk];
 
-        ssProgressTitle << LogInfo.getPrefixString() << "Read from disk: "
-                        << GenericToolbox::padString(GenericToolbox::parseSizeUnits(readSpeed.getTotalAccumulated()), 8) << " ("
-                        << GenericToolbox::padString(GenericToolbox::parseSizeUnits(readSpeed.evalTotalGrowthRate()), 8) << "/s)";
+      for ( Long64_t iEntry = chunk.beginEntry ; iEntry < chunk.endEntry ; iEntry++ ) {
+        if( iThread_ == 0 ){
+          readSpeed.addQuantity(treeChain->GetEntry(iEntry)*nThreads);
+          if (GenericToolbox::showProgressBar(iEntry, nEvents)) {
+            ssProgressTitle.str("");
 
-        int cpuPercent = int(GenericToolbox::getCpuUsageByProcess());
-        ssProgressTitle << " / CPU efficiency: " << GenericToolbox::padString(std::to_string(cpuPercent/nThreads), 3,' ')
-                        << "%" << std::endl;
+            ssProgressTitle << LogInfo.getPrefixString() << "Read from disk: "
+                            << GenericToolbox::padString(GenericToolbox::parseSizeUnits(readSpeed.getTotalAccumulated()), 8) << " ("
+                            << GenericToolbox::padString(GenericToolbox::parseSizeUnits(readSpeed.evalTotalGrowthRate()), 8) << "/s)";
 
-        ssProgressTitle << LogInfo.getPrefixString() << progressTitle;
-        GenericToolbox::displayProgressBar(iGlobal, nEvents, ssProgressTitle.str());
-      }
-      iGlobal += nThreads;
-    }
-    else{
-      treeChain->GetEntry(iEntry);
-    }
+            int cpuPercent = int(GenericToolbox::getCpuUsageByProcess());
+            ssProgressTitle << " / CPU efficiency: " << GenericToolbox::padString(std::to_string(cpuPercent/nThreads), 3,' ')
+                            << "%" << std::endl;
 
-    if ( selectionCutLeafFormIndex != -1 ){
-      if( lCollection.getLeafFormList()[selectionCutLeafFormIndex].evalAsDouble() == 0 ){
-        for (size_t iSample = 0; iSample < _cache_.samplesToFillList.size(); iSample++) {
-          _cache_.threadSelectionResults[iThread_].eventIsInSamplesList[iEntry][iSample] = false;
+            ssProgressTitle << LogInfo.getPrefixString() << progressTitle;
+            GenericToolbox::displayProgressBar(iEntry, nEvents, ssProgressTitle.str());
+          }
         }
-        if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
-          LogTrace << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
-                   << " rejected because of " << _parameters_.selectionCutFormulaStr << std::endl;
+        else{
+          treeChain->GetEntry(iEntry);
         }
-        continue;
-      }
-    }
-
-    for( auto& sampleCut : sampleCutList ){
 
-      // no cut?
-      if( sampleCut.cutIndex == -1 ){
-        _cache_.threadSelectionResults[iThread_].eventIsInSamplesList[iEntry][sampleCut.sampleIndex] = true;
-        _cache_.threadSelectionResults[iThread_].sampleNbOfEvents[sampleCut.sampleIndex]++;
-        if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
-          LogDebug << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
-                   << " included as sample " << sampleCut.sampleIndex << " (NO SELECTION CUT)" << std::endl;
-        }
-      }
-        // pass cut?
-      else if( lCollection.getLeafFormList()[sampleCut.cutIndex].evalAsDouble() != 0 ){
-        _cache_.threadSelectionResults[iThread_].eventIsInSamplesList[iEntry][sampleCut.sampleIndex] = true;
-        _cache_.threadSelectionResults[iThread_].sampleNbOfEvents[sampleCut.sampleIndex]++;
-        if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
-          LogDebug << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
-                   << " included as sample " << sampleCut.sampleIndex << " because of "
-                   << lCollection.getLeafFormList()[sampleCut.cutIndex].getSummary() << std::endl;
+        if ( selectionCuts.globalCutIndex != -1 ){
+          if( lCollection.getLeafFormList()[selectionCuts.globalCutIndex].evalAsDouble() == 0 ){
+            if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
+              LogTrace << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
+                       << " rejected because of " << _parameters_.selectionCutFormulaStr << std::endl;
+            }
+            continue;
+          }
         }
-      }
-        // don't pass cut?
-      else {
-        if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
-          LogTrace << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
-                   << " rejected as sample " << sampleCut.sampleIndex << " because of "
-                   << lCollection.getLeafFormList()[sampleCut.cutIndex].getSummary() << std::endl;
+
+        for( size_t iSample = 0 ; iSample < nSamples ; iSample++ ){
+          int cutIndex{selectionCuts.sampleCutIndexList[iSample]};
+
+          // no cut?
+          if( cutIndex == -1 ){
+            _cache_.selectionBitmap.set( chunk.getSelectionBit(iEntry, iSample, nSamples) );
+            chunk.sampleNbOfEvents[iSample]++;
+            if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
+              LogDebug << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
+                       << " included as sample " << iSample << " (NO SELECTION CUT)" << std::endl;
+            }
+          }
+            // pass cut?
+          else if( lCollection.getLeafFormList()[cutIndex].evalAsDouble() != 0 ){
+            _cache_.selectionBitmap.set( chunk.getSelectionBit(iEntry, iSample, nSamples) );
+            chunk.sampleNbOfEvents[iSample]++;
+            if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
+              LogDebug << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
+                       << " included as sample " << iSample << " because of "
+                       << lCollection.getLeafFormList()[cutIndex].getSummary() << std::endl;
+            }
+          }
+            // don't pass cut?
+          else {
+            if (GundamGlobals::getVerboseLevel() == VerboseLevel::INLOOP_TRACE) {
+              LogTrace << "Event #" << treeChain->GetFileNumber() << ":" << treeChain->GetReadEntry()
+                       << " rejected as sample " << iSample << " because of "
+                       << lCollection.getLeafFormList()[cutIndex].getSummary() << std::endl;
+            }
+          }
         }
-      }
-    }
 
-  } // iEvent
+      } // iEvent
+    } // iChunk
+  } // iRange
 
   if( iThread_ == 0 ){ GenericToolbox::displayProgressBar(nEvents, nEvents, ssProgressTitle.str()); }
 
 }
-void DataDispenser::fillFunction(int iThread_){
-
-  int nThreads = GundamGlobals::getParallelWorker().getNbThreads();
-  if( iThread_ == -1 ){ iThread_ = 0; nThreads = 1; } // special mode
-
-  auto treeChain = this->openChain();
-
-  GenericToolbox::LeafCollection lCollection;
-  lCollection.setTreePtr( treeChain.get() );
+void DataDispenser::initEntryReader(DataDispenserEntryReader& reader_, bool verbose_){
+  reader_.treeChain = this->openChain();
+  reader_.nEntries = reader_.treeChain->GetEntries();
+  reader_.lCollection.setTreePtr( reader_.treeChain.get() );
 
   // nominal weight
-  TTreeFormula* nominalWeightTreeFormula{nullptr};
   if( not _parameters_.nominalWeightFormulaStr.empty() ){
-    auto idx = size_t(lCollection.addLeafExpression( _parameters_.nominalWeightFormulaStr ));
-    nominalWeightTreeFormula = (TTreeFormula*) idx; // tweaking types. Ptr will be attributed after init
+    auto idx = size_t(reader_.lCollection.addLeafExpression( _parameters_.nominalWeightFormulaStr ));
+    reader_.nominalWeightTreeFormula = (TTreeFormula*) idx; // tweaking types. Ptr will be attributed after init
   }
 
   // dial array index
-  TTreeFormula* dialIndexTreeFormula{nullptr};
   if( not _parameters_.dialIndexFormula.empty() ){
-    auto idx = size_t(lCollection.addLeafExpression( _parameters_.dialIndexFormula ));
-    dialIndexTreeFormula = (TTreeFormula*) idx; // tweaking types. Ptr will be attributed after init
+    auto idx = size_t(reader_.lCollection.addLeafExpression( _parameters_.dialIndexFormula ));
+    reader_.dialIndexTreeFormula = (TTreeFormula*) idx; // tweaking types. Ptr will be attributed after init
   }
 
 
   // variables definition
-  std::vector<const GenericToolbox::LeafForm*> leafFormIndexingList{};
-  std::vector<const GenericToolbox::LeafForm*> leafFormStorageList{};
   for( auto& var : _cache_.varsRequestedForIndexing ){
     std::string leafExp{var};
     if( GenericToolbox::isIn( var, _parameters_.variableDict ) ){
       leafExp = _parameters_.variableDict[leafExp];
     }
-    auto idx = size_t(lCollection.addLeafExpression(leafExp));
-    leafFormIndexingList.emplace_back( (GenericToolbox::LeafForm*) idx ); // tweaking types
+    auto idx = size_t(reader_.lCollection.addLeafExpression(leafExp));
+    reader_.leafFormIndexingList.emplace_back( (GenericToolbox::LeafForm*) idx ); // tweaking types
   }
   for( auto& var : _cache_.varsRequestedForStorage ){
     std::string leafExp{var};
     if( GenericToolbox::isIn( var, _parameters_.variableDict ) ){
       leafExp = _parameters_.variableDict[leafExp];
     }
-    auto idx = size_t(lCollection.getLeafExpIndex(leafExp));
-    leafFormStorageList.emplace_back( (GenericToolbox::LeafForm*) idx ); // tweaking types
+    auto idx = size_t(reader_.lCollection.getLeafExpIndex(leafExp));
+    reader_.leafFormStorageList.emplace_back( (GenericToolbox::LeafForm*) idx ); // tweaking types
   }
 
-  lCollection.initialize();
+  // single pass: the selection is evaluated on the entries read for the fill
+  if( _cache_.isSinglePassLoading ){
+    reader_.selectionCuts = this->defineSelectionCuts( reader_.lCollection, verbose_ );
+  }
+
+  reader_.lCollection.initialize();
 
   // grab ptr address now
   if( not _parameters_.nominalWeightFormulaStr.empty() ){
-    nominalWeightTreeFormula = lCollection.getLeafFormList()[(size_t) nominalWeightTreeFormula].getTreeFormulaPtr().get();
+    reader_.nominalWeightTreeFormula = reader_.lCollection.getLeafFormList()[(size_t) reader_.nominalWeightTreeFormula].getTreeFormulaPtr().get();
   }
   if( not _parameters_.dialIndexFormula.empty() ){
-    dialIndexTreeFormula = lCollection.getLeafFormList()[(size_t) dialIndexTreeFormula].getTreeFormulaPtr().get();
+    reader_.dialIndexTreeFormula = reader_.lCollection.getLeafFormList()[(size_t) reader_.dialIndexTreeFormula].getTreeFormulaPtr().get();
   }
-  for( auto& lfInd: leafFormIndexingList ){ lfInd = &(lCollection.getLeafFormList()[(size_t) lfInd]); }
-  for( auto& lfSto: leafFormStorageList ){ lfSto = &(lCollection.getLeafFormList()[(size_t) lfSto]); }
+  for( auto& lfInd: reader_.leafFormIndexingList ){ lfInd = &(reader_.lCollection.getLeafFormList()[(size_t) lfInd]); }
+  for( auto& lfSto: reader_.leafFormStorageList ){ lfSto = &(reader_.lCollection.getLeafFormList()[(size_t) lfSto]); }
 
-  // Event Var Transform
-  auto eventVarTransformList = _cache_.eventVarTransformList; // copy for cache
-  std::vector<EventVarTransformLib*> varTransformForIndexingList;
-  std::vector<EventVarTransformLib*> varTransformForStorageList;
-  for( auto& eventVarTransform : eventVarTransformList ){
-    if( GenericToolbox::doesElementIsInVector(eventVarTransform.getOutputVariableName(), _cache_.varsRequestedForIndexing) ){
-      varTransformForIndexingList.emplace_back(&eventVarTransform);
-    }
-    if( GenericToolbox::doesElementIsInVector(eventVarTransform.getOutputVariableName(), _cache_.varsRequestedForStorage) ){
-      varTransformForStorageList.emplace_back(&eventVarTransform);
-    }
-  }
+  // shared by the entry buffers of this reader
+  reader_.indexingVarNameListPtr = std::make_shared<std::vector<std::string>>(_cache_.varsRequestedForIndexing);
+  reader_.storageVarNameListPtr = std::make_shared<std::vector<std::string>>(_cache_.varsRequestedForStorage);
 
-  if( iThread_ == 0 ){
-    if( not varTransformForIndexingList.empty() ){
-      LogInfo << "EventVarTransformLib used for indexing: "
-              << GenericToolbox::toString(
-                  varTransformForIndexingList,
-                  [](const EventVarTransformLib* elm_){ return "\"" + elm_->getName() + "\"";}, false)
-              << std::endl;
-    }
-    if( not varTransformForStorageList.empty() ){
-      LogInfo << "EventVarTransformLib used for storage: "
-              << GenericToolbox::toString(
-                  varTransformForStorageList,
-                  []( const EventVarTransformLib* elm_){ return "\"" + elm_->getName() + "\""; }, false)
-              << std::endl;
-    }
-  }
-
-  // buffer that will store the data for indexing
-  Event eventIndexingBuffer;
-  eventIndexingBuffer.getIndices().dataset = _owner_->getDataSetIndex();
-  eventIndexingBuffer.getVariables().setVarNameList(std::make_shared<std::vector<std::string>>(_cache_.varsRequestedForIndexing));
-  eventIndexingBuffer.getVariables().allocateMemory(leafFormIndexingList);
-
-  Event eventStorageBuffer;
-  eventStorageBuffer.getIndices().dataset = _owner_->getDataSetIndex();
-  eventStorageBuffer.getVariables().setVarNameList(std::make_shared<std::vector<std::string>>(_cache_.varsRequestedForStorage));
-  eventStorageBuffer.getVariables().allocateMemory(leafFormStorageList);
-
-  if(iThread_ == 0){
+  if( verbose_ ){
     LogInfo << "Feeding event variables with:" << std::endl;
     GenericToolbox::TablePrinter table;
 
@@ -890,21 +1097,21 @@ void DataDispenser::fillFunction(int iThread_){
         table.setColorBuffer(GenericToolbox::ColorCodes::blueBackground);
       }
       else if(
-          leafFormIndexingList[iVar]->getLeafTypeName() == "TClonesArray"
-          or leafFormIndexingList[iVar]->getLeafTypeName() == "TGraph"
+          reader_.leafFormIndexingList[iVar]->getLeafTypeName() == "TClonesArray"
+          or reader_.leafFormIndexingList[iVar]->getLeafTypeName() == "TGraph"
           ){
         table.setColorBuffer( GenericToolbox::ColorCodes::magentaBackground );
       }
 
       table << var << GenericToolbox::TablePrinter::NextColumn;
 
-      table << leafFormIndexingList[iVar]->getPrimaryExprStr() << "/" << leafFormIndexingList[iVar]->getLeafTypeName();
+      table << reader_.leafFormIndexingList[iVar]->getPrimaryExprStr() << "/" << reader_.leafFormIndexingList[iVar]->getLeafTypeName();
       table << GenericToolbox::TablePrinter::NextColumn;
 
       std::vector<std::string> transformsList;
-      for( auto* varTransformForIndexing : varTransformForIndexingList ){
-        if( varTransformForIndexing->getOutputVariableName() == var ){
-          transformsList.emplace_back(varTransformForIndexing->getName());
+      for( auto& eventVarTransform : _cache_.eventVarTransformList ){
+        if( eventVarTransform.getOutputVariableName() == var ){
+          transformsList.emplace_back(eventVarTransform.getName());
         }
       }
       table << GenericToolbox::toString(transformsList) << GenericToolbox::TablePrinter::NextColumn;
@@ -921,231 +1128,495 @@ void DataDispenser::fillFunction(int iThread_){
       LogAlert << "Loading data in single thread (devSingleThreadEventLoaderAndIndexer option set to true)" << std::endl;
     }
   }
+}
+void DataDispenser::initEventBuilder(DataDispenserEventBuilder& builder_, bool verbose_){
+  // Event Var Transform
+  builder_.eventVarTransformList = _cache_.eventVarTransformList; // copy for cache
+  for( auto& eventVarTransform : builder_.eventVarTransformList ){
+    if( GenericToolbox::doesElementIsInVector(eventVarTransform.getOutputVariableName(), _cache_.varsRequestedForIndexing) ){
+      builder_.varTransformForIndexingList.emplace_back(&eventVarTransform);
+    }
+    if( GenericToolbox::doesElementIsInVector(eventVarTransform.getOutputVariableName(), _cache_.varsRequestedForStorage) ){
+      builder_.varTransformForStorageList.emplace_back(&eventVarTransform);
+    }
+  }
 
-  // Try to read TTree the closest to sequentially possible
-  Long64_t nEvents{treeChain->GetEntries()};
+  if( verbose_ ){
+    if( not builder_.varTransformForIndexingList.empty() ){
+      LogInfo << "EventVarTransformLib used for indexing: "
+              << GenericToolbox::toString(
+                  builder_.varTransformForIndexingList,
+                  [](const EventVarTransformLib* elm_){ return "\"" + elm_->getName() + "\"";}, false)
+              << std::endl;
+    }
+    if( not builder_.varTransformForStorageList.empty() ){
+      LogInfo << "EventVarTransformLib used for storage: "
+              << GenericToolbox::toString(
+                  builder_.varTransformForStorageList,
+                  []( const EventVarTransformLib* elm_){ return "\"" + elm_->getName() + "\""; }, false)
+              << std::endl;
+    }
+  }
+}
+void DataDispenser::initEntryBuffer(DataDispenserEntryBuffer& entry_, const DataDispenserEntryReader& reader_){
+  entry_.isInSampleList.resize(_cache_.samplesToFillList.size(), false);
 
-  auto bounds = GenericToolbox::ParallelWorker::getThreadBoundIndices( iThread_, nThreads, nEvents );
+  // buffer that will store the data for indexing
+  entry_.indexingBuffer.getIndices().dataset = _owner_->getDataSetIndex();
+  entry_.indexingBuffer.getVariables().setVarNameList(reader_.indexingVarNameListPtr);
+  entry_.indexingBuffer.getVariables().allocateMemory(reader_.leafFormIndexingList);
 
-  // Load the branches
-  treeChain->LoadTree(bounds.beginIndex);
+  entry_.storageBuffer.getIndices().dataset = _owner_->getDataSetIndex();
+  entry_.storageBuffer.getVariables().setVarNameList(reader_.storageVarNameListPtr);
+  entry_.storageBuffer.getVariables().allocateMemory(reader_.leafFormStorageList);
 
-  // IO speed monitor
-  GenericToolbox::VariableMonitor readSpeed("bytes");
+  entry_.dialBaseList.resize(_cache_.propagatorPtr->getDialCollectionList().size());
+}
+void DataDispenser::printFillProgress(DataDispenserEntryReader& reader_, Long64_t iEntry_, int nReaderThreads_, int nThreads_){
+  if( not GenericToolbox::showProgressBar(iEntry_, reader_.nEntries) ){ return; }
 
-  std::string progressTitle = "Loading and indexing...";
-  std::stringstream ssProgressBar;
+  // only one of the readers is monitored
+  reader_.ssProgressBar.str("");
 
-  for( Long64_t iEntry = bounds.beginIndex ; iEntry < bounds.endIndex; iEntry++ ){
+  reader_.ssProgressBar << LogInfo.getPrefixString() << "Reading from disk: "
+                        << GenericToolbox::padString(GenericToolbox::parseSizeUnits(double(reader_.readSpeed.getTotalAccumulated()) * nReaderThreads_), 8) << " ("
+                        << GenericToolbox::padString(GenericToolbox::parseSizeUnits(double(reader_.readSpeed.evalTotalGrowthRate()) * nReaderThreads_), 8) << "/s)";
 
-    if( iThread_ == 0 ){
-      if( GenericToolbox::showProgressBar(iEntry*nThreads, nEvents) ){
+  int cpuPercent = int(GenericToolbox::getCpuUsageByProcess());
+  reader_.ssProgressBar << " / CPU efficiency: " << GenericToolbox::padString(std::to_string(cpuPercent/nThreads_), 3,' ')
+                        << "% / RAM: " << GenericToolbox::parseSizeUnits( double(GenericToolbox::getProcessMemoryUsage()) ) << std::endl;
 
-        ssProgressBar.str("");
+  reader_.ssProgressBar << LogInfo.getPrefixString() << "Loading and indexing...";
+  GenericToolbox::displayProgressBar(iEntry_, reader_.nEntries, reader_.ssProgressBar.str());
+}
+bool DataDispenser::readEntry(DataDispenserEntryReader& reader_, Long64_t iEntry_, const DataDispenserCache::EntryChunk& chunk_,
+                              DataDispenserFillBuffer* fillBuffer_, DataDispenserEntryBuffer& entry_){
+  size_t nSample{_cache_.samplesToFillList.size()};
 
-        ssProgressBar << LogInfo.getPrefixString() << "Reading from disk: "
-                      << GenericToolbox::padString(GenericToolbox::parseSizeUnits(readSpeed.getTotalAccumulated()), 8) << " ("
-                      << GenericToolbox::padString(GenericToolbox::parseSizeUnits(readSpeed.evalTotalGrowthRate()), 8) << "/s)";
+  // the entries that passed no cut are not even read
+  if( not _cache_.isSinglePassLoading ){
+    bool hasSample{false};
+    for( size_t iSample = 0 ; iSample < nSample ; iSample++ ){
+      entry_.isInSampleList[iSample] = _cache_.selectionBitmap.isSet( chunk_.getSelectionBit(iEntry_, iSample, nSample) );
+      if( entry_.isInSampleList[iSample] ){ hasSample = true; }
+    }
+    if( not hasSample ){ return false; }
+  }
 
-        int cpuPercent = int(GenericToolbox::getCpuUsageByProcess());
-        ssProgressBar << " / CPU efficiency: " << GenericToolbox::padString(std::to_string(cpuPercent/nThreads), 3,' ')
-                      << "% / RAM: " << GenericToolbox::parseSizeUnits( double(GenericToolbox::getProcessMemoryUsage()) ) << std::endl;
+  // monitor
+  reader_.readSpeed.addQuantity( reader_.treeChain->GetEntry(iEntry_) );
 
-        ssProgressBar << LogInfo.getPrefixString() << progressTitle;
-        GenericToolbox::displayProgressBar(iEntry*nThreads, nEvents, ssProgressBar.str());
-      }
+  if( _cache_.isSinglePassLoading ){
+    if( not this->evalSelectionCuts( reader_.lCollection, reader_.selectionCuts, entry_.isInSampleList ) ){ return false; }
+    for( size_t iSample = 0 ; iSample < nSample ; iSample++ ){
+      if( entry_.isInSampleList[iSample] ){ fillBuffer_->sampleNbOfEvents[iSample]++; }
     }
+  }
+
+  auto* nominalWeightTreeFormula = reader_.nominalWeightTreeFormula;
+  if( nominalWeightTreeFormula != nullptr ){
+    entry_.indexingBuffer.getWeights().base = (nominalWeightTreeFormula->EvalInstance());
+    if( entry_.indexingBuffer.getWeights().base < 0 ){
+      LogError << "Negative nominal weight:" << std::endl;
 
-    bool hasSample =
-        std::any_of(
-            _cache_.eventIsInSamplesList[iEntry].begin(), _cache_.eventIsInSamplesList[iEntry].end(),
-            [](bool isInSample_){ return isInSample_; }
-        );
-    if( not hasSample ){ continue; }
+      LogError << "Event buffer is: " << entry_.indexingBuffer.getSummary() << std::endl;
 
-    Int_t nBytes{ treeChain->GetEntry(iEntry) };
+      LogError << "Formula leaves:" << std::endl;
+      for( int iLeaf = 0 ; iLeaf < nominalWeightTreeFormula->GetNcodes() ; iLeaf++ ){
+        if( nominalWeightTreeFormula->GetLeaf(iLeaf) == nullptr ) continue; // for "Entry$" like dummy leaves
+        LogError << "Leaf: " << nominalWeightTreeFormula->GetLeaf(iLeaf)->GetName() << "[0] = " << nominalWeightTreeFormula->GetLeaf(iLeaf)->GetValue(0) << std::endl;
+      }
 
-    // monitor
-    if( iThread_ == 0 ){
-      readSpeed.addQuantity(nBytes * nThreads);
+      LogThrow("Negative nominal weight");
     }
+    if( entry_.indexingBuffer.getWeights().base == 0 ){
+      return false;
+    } // skip this event
+  }
 
-    if( nominalWeightTreeFormula != nullptr ){
-      eventIndexingBuffer.getWeights().base = (nominalWeightTreeFormula->EvalInstance());
-      if( eventIndexingBuffer.getWeights().base < 0 ){
-        LogError << "Negative nominal weight:" << std::endl;
+  // Getting loaded data in the entry buffer
+  entry_.iEntry = iEntry_;
+  entry_.indexingBuffer.getVariables().copyData( reader_.leafFormIndexingList );
+  entry_.storageBuffer.getVariables().copyData( reader_.leafFormStorageList );
 
-        LogError << "Event buffer is: " << eventIndexingBuffer.getSummary() << std::endl;
+  if( not _parameters_.useMcContainer ){ return true; }
 
-        LogError << "Formula leaves:" << std::endl;
-        for( int iLeaf = 0 ; iLeaf < nominalWeightTreeFormula->GetNcodes() ; iLeaf++ ){
-          if( nominalWeightTreeFormula->GetLeaf(iLeaf) == nullptr ) continue; // for "Entry$" like dummy leaves
-          LogError << "Leaf: " << nominalWeightTreeFormula->GetLeaf(iLeaf)->GetName() << "[0] = " << nominalWeightTreeFormula->GetLeaf(iLeaf)->GetValue(0) << std::endl;
-        }
+  // event-by-event dials: the knots are read from the branch objects, which
+  // are not copied (TObject::Clone takes the ROOT global lock)
+  for( auto *dialCollectionRef: _cache_.dialCollectionsRefList ){
+    if( dialCollectionRef->isBinned() or dialCollectionRef->getGlobalDialLeafName().empty() ){ continue; }
 
-        LogThrow("Negative nominal weight");
-      }
-      if( eventIndexingBuffer.getWeights().base == 0 ){
-        continue;
-      } // skip this event
+    // grab the dial as a general TObject -> let the factory figure out what to do with it
+    auto *dialObjectPtr = (TObject *) *(
+        (TObject **) entry_.indexingBuffer.getVariables().fetchVariable(
+            dialCollectionRef->getGlobalDialLeafName()
+        ).get().getPlaceHolderPtr()->getVariableAddress()
+    );
+
+    // Extra-step for selecting the right dial with TClonesArray
+    if (not strcmp(dialObjectPtr->ClassName(), "TClonesArray")) {
+      dialObjectPtr = ((TClonesArray *) dialObjectPtr)->At(
+          (reader_.dialIndexTreeFormula == nullptr ? 0 : int(reader_.dialIndexTreeFormula->EvalInstance()))
+      );
     }
 
-    size_t nSample{_cache_.samplesToFillList.size()};
-    for( size_t iSample = 0 ; iSample < nSample ; iSample++ ){
+    // Do the unique_ptr dance so that memory gets deleted if
+    // there is an exception (being stupidly paranoid).
+    DialBaseFactory factory{};
+    auto& dialBase = entry_.dialBaseList[dialCollectionRef->getIndex()];
+    dialBase.reset(
+        factory.makeDial(
+            dialCollectionRef->getTitle(),
+            dialCollectionRef->getGlobalDialType(),
+            dialCollectionRef->getGlobalDialSubType(),
+            dialObjectPtr,
+            false
+        )
+    );
+    if( dialBase != nullptr ){ dialBase->setAllowExtrapolation(dialCollectionRef->isAllowDialExtrapolation()); }
+  }
 
-      if( not _cache_.eventIsInSamplesList[iEntry][iSample] ){ continue; }
+  return true;
+}
+bool DataDispenser::buildEvents(DataDispenserEventBuilder& builder_, DataDispenserEntryBuffer& entry_,
+                                DataDispenserCache::EntryChunk& chunk_, DataDispenserFillBuffer* fillBuffer_, bool verbose_){
 
-      // Getting loaded data in tEventBuffer
-      eventIndexingBuffer.getVariables().copyData( leafFormIndexingList );
+  // same layout for all the entry buffers
+  auto& eventIndexingBuffer = builder_.eventIndexingBuffer;
+  if( eventIndexingBuffer.getVariables().getNameListPtr() == nullptr ){ eventIndexingBuffer = entry_.indexingBuffer; }
 
-      // Propagate variable transformations for indexing
-      for( auto* varTransformPtr : varTransformForIndexingList ){
-        varTransformPtr->evalAndStore(eventIndexingBuffer);
-      }
+  for( size_t iSample = 0 ; iSample < entry_.isInSampleList.size() ; iSample++ ){
 
-      // Look for the bin index
-      eventIndexingBuffer.fillBinIndex( _cache_.samplesToFillList[iSample]->getBinning() );
-
-      // No bin found -> next sample
-      if( eventIndexingBuffer.getIndices().bin == -1){ break; }
-
-      // OK, now we have a valid fit bin. Let's claim an index.
-      // Shared index among threads
-      size_t sampleEventIndex{};
-      EventDialCache::IndexedCacheEntry* eventDialCacheEntry{nullptr};
-      {
-        std::unique_lock<std::mutex> lock(GundamGlobals::getThreadMutex());
-        if( _parameters_.useMcContainer ){
-
-          if( _parameters_.debugNbMaxEventsToLoad != 0 ){
-            // check if the limit has been reached
-            if( _cache_.propagatorPtr->getEventDialCache().getFillIndex() >= _parameters_.debugNbMaxEventsToLoad ){
-              LogAlertIf(iThread_==0) << std::endl << std::endl; // flush pBar
-              LogAlertIf(iThread_==0) << "debugNbMaxEventsToLoad: Event number cap reached (";
-              LogAlertIf(iThread_==0) << _parameters_.debugNbMaxEventsToLoad << ")" << std::endl;
-              return;
-            }
-          }
+    if( not entry_.isInSampleList[iSample] ){ continue; }
+    bool isLastSample{std::find( entry_.isInSampleList.begin() + iSample + 1, entry_.isInSampleList.end(), true ) == entry_.isInSampleList.end()};
+
+    // Getting loaded data in tEventBuffer
+    eventIndexingBuffer.getVariables().copyData( entry_.indexingBuffer.getVariables() );
 
-          eventDialCacheEntry = _cache_.propagatorPtr->getEventDialCache().fetchNextCacheEntry();
+    // Propagate variable transformations for indexing
+    for( auto* varTransformPtr : builder_.varTransformForIndexingList ){
+      varTransformPtr->evalAndStore(eventIndexingBuffer);
+    }
+
+    // Look for the bin index
+    eventIndexingBuffer.fillBinIndex( _cache_.samplesToFillList[iSample]->getBinning() );
+
+    // No bin found -> next sample
+    if( eventIndexingBuffer.getIndices().bin == -1){ break; }
+
+    // OK, now we have a valid fit bin. Let's claim an index.
+    size_t sampleEventIndex{};
+    Event *eventPtr{nullptr};
+    EventDialCache::IndexedCacheEntry* eventDialCacheEntry{nullptr};
+    if( fillBuffer_ != nullptr ){
+      // index within the chunk buffer, shifted when merging
+      sampleEventIndex = fillBuffer_->sampleEventList[iSample].size();
+      fillBuffer_->sampleEventList[iSample].emplace_back( _cache_.eventPlaceholder );
+      eventPtr = &fillBuffer_->sampleEventList[iSample].back();
+      if( _parameters_.useMcContainer ){
+        fillBuffer_->sampleCacheEntryList[iSample].emplace_back();
+        eventDialCacheEntry = &fillBuffer_->sampleCacheEntryList[iSample].back();
+        eventDialCacheEntry->dials.resize( _cache_.dialCollectionsRefList.size() );
+      }
+    }
+    else{
+      // slots assigned before the fill: nothing is shared with the other threads
+      if( _parameters_.useMcContainer ){
+
+        if( _parameters_.debugNbMaxEventsToLoad != 0 ){
+          // check if the limit has been reached
+          if( chunk_.cacheEntryOffset + chunk_.nLoadedCacheEntries >= _parameters_.debugNbMaxEventsToLoad ){
+            LogAlertIf(verbose_) << std::endl << std::endl; // flush pBar
+            LogAlertIf(verbose_) << "debugNbMaxEventsToLoad: Event number cap reached (";
+            LogAlertIf(verbose_) << _parameters_.debugNbMaxEventsToLoad << ")" << std::endl;
+            return false;
+          }
         }
-        sampleEventIndex = _cache_.sampleIndexOffsetList[iSample]++;
+
+        eventDialCacheEntry = &chunk_.cacheEntryPtr[chunk_.nLoadedCacheEntries++];
       }
+      sampleEventIndex = chunk_.sampleEventOffsetList[iSample] + chunk_.sampleNbOfLoadedEvents[iSample]++;
 
       // Get the next free event in our buffer
-      Event *eventPtr = &(*_cache_.sampleEventListPtrToFill[iSample])[sampleEventIndex];
+      eventPtr = &(*_cache_.sampleEventListPtrToFill[iSample])[sampleEventIndex];
+    }
 
-      // fill meta info
-      eventPtr->getIndices().entry = iEntry;
-      eventPtr->getIndices().sample = _cache_.samplesToFillList[iSample]->getIndex();
-      eventPtr->getIndices().bin = eventIndexingBuffer.getIndices().bin;
-      eventPtr->getWeights().base = eventIndexingBuffer.getWeights().base;
-      eventPtr->getWeights().resetCurrentWeight();
+    // fill meta info
+    eventPtr->getIndices().entry = entry_.iEntry;
+    eventPtr->getIndices().sample = _cache_.samplesToFillList[iSample]->getIndex();
+    eventPtr->getIndices().bin = eventIndexingBuffer.getIndices().bin;
+    eventPtr->getWeights().base = entry_.indexingBuffer.getWeights().base;
+    eventPtr->getWeights().resetCurrentWeight();
 
-      // drop the content of the leaves
-      eventPtr->getVariables().copyData( leafFormStorageList );
+    // drop the content of the leaves
+    eventPtr->getVariables().copyData( entry_.storageBuffer.getVariables() );
 
-      // Propagate transformation for storage -> use the previous results calculated for indexing
-      for( auto *varTransformPtr: varTransformForStorageList ){
-        varTransformPtr->storeCachedOutput(*eventPtr);
-      }
+    // Propagate transformation for storage -> use the previous results calculated for indexing
+    for( auto *varTransformPtr: builder_.varTransformForStorageList ){
+      varTransformPtr->storeCachedOutput(*eventPtr);
+    }
 
-      // Now the event is ready. Let's index the dials:
-      if ( eventDialCacheEntry != nullptr) {
-        // there should always be a cache entry even if no dials are applied.
-        // This cache is actually used to write MC events with dials in output tree
-        eventDialCacheEntry->event.sampleIndex = std::size_t(_cache_.samplesToFillList[iSample]->getIndex());
-        eventDialCacheEntry->event.eventIndex = sampleEventIndex;
+    // Now the event is ready. Let's index the dials:
+    if ( eventDialCacheEntry != nullptr) {
+      // there should always be a cache entry even if no dials are applied.
+      // This cache is actually used to write MC events with dials in output tree
+      eventDialCacheEntry->event.sampleIndex = std::size_t(_cache_.samplesToFillList[iSample]->getIndex());
+      eventDialCacheEntry->event.eventIndex = sampleEventIndex;
 
-        auto* dialEntryPtr = &eventDialCacheEntry->dials[0];
+      auto* dialEntryPtr = &eventDialCacheEntry->dials[0];
 
-        for( auto *dialCollectionRef: _cache_.dialCollectionsRefList ){
+      for( auto *dialCollectionRef: _cache_.dialCollectionsRefList ){
 
-          // dial collections may come with a condition formula
-          if( dialCollectionRef->getApplyConditionFormula() != nullptr ){
-            if( eventIndexingBuffer.getVariables().evalFormula(dialCollectionRef->getApplyConditionFormula().get()) == 0 ){
-              // next dialSet
-              continue;
-            }
+        // dial collections may come with a condition formula
+        if( dialCollectionRef->getApplyConditionFormula() != nullptr ){
+          if( eventIndexingBuffer.getVariables().evalFormula(dialCollectionRef->getApplyConditionFormula().get()) == 0 ){
+            // next dialSet
+            continue;
           }
+        }
 
-          int iCollection = dialCollectionRef->getIndex();
+        int iCollection = dialCollectionRef->getIndex();
 
-          if     ( dialCollectionRef->isBinned() ){
+        if     ( dialCollectionRef->isBinned() ){
 
-            // is only one bin with no condition:
-            if( dialCollectionRef->getDialBaseList().size() == 1 and dialCollectionRef->getDialBinSet().getBinList().empty() ){
-              // if is it NOT a DialBinned -> this is the one we are
-              // supposed to use
+          // is only one bin with no condition:
+          if( dialCollectionRef->getDialBaseList().size() == 1 and dialCollectionRef->getDialBinSet().getBinList().empty() ){
+            // if is it NOT a DialBinned -> this is the one we are
+            // supposed to use
+            dialEntryPtr->collectionIndex = iCollection;
+            dialEntryPtr->interfaceIndex = 0;
+            dialEntryPtr++;
+          }
+          else{
+            auto dialBinIdx = eventIndexingBuffer.getVariables().findBinIndex( dialCollectionRef->getDialBinSet() );
+            if( dialBinIdx != -1 ){
               dialEntryPtr->collectionIndex = iCollection;
-              dialEntryPtr->interfaceIndex = 0;
+              dialEntryPtr->interfaceIndex = dialBinIdx;
               dialEntryPtr++;
             }
+          }
+        }
+        else if( not dialCollectionRef->getGlobalDialLeafName().empty() ){
+          // Event-by-event dial: it has been built with the entry. Only the
+          // last sample of the entry takes it, the others get a copy.
+          std::unique_ptr<DialBase> dialBase{nullptr};
+          if( entry_.dialBaseList[iCollection] != nullptr ){
+            if( isLastSample ){ dialBase = std::move( entry_.dialBaseList[iCollection] ); }
+            else{ dialBase = entry_.dialBaseList[iCollection]->clone(); }
+          }
+
+          // dialBase is valid -> store it (or share an identical one)
+          if (dialBase != nullptr) {
+            dialEntryPtr->collectionIndex = iCollection;
+            if( fillBuffer_ == nullptr ){
+              dialEntryPtr->interfaceIndex = dialCollectionRef->storeEventDial( std::move(dialBase) );
+            }
             else{
-              auto dialBinIdx = eventIndexingBuffer.getVariables().findBinIndex( dialCollectionRef->getDialBinSet() );
-              if( dialBinIdx != -1 ){
-                dialEntryPtr->collectionIndex = iCollection;
-                dialEntryPtr->interfaceIndex = dialBinIdx;
-                dialEntryPtr++;
-              }
+              // index within the chunk buffer: the dial slots are created when merging
+              dialEntryPtr->interfaceIndex = fillBuffer_->eventDialList.size();
+              fillBuffer_->eventDialList.emplace_back( std::move(dialBase) );
+              fillBuffer_->collectionNbOfEventDials[iCollection]++;
             }
+            dialEntryPtr++;
           }
-          else if( not dialCollectionRef->getGlobalDialLeafName().empty() ){
-            // Event-by-event dial?
-            // grab the dial as a general TObject -> let the factory figure out what to do with it
-
-            auto *dialObjectPtr = (TObject *) *(
-                (TObject **) eventIndexingBuffer.getVariables().fetchVariable(
-                    dialCollectionRef->getGlobalDialLeafName()
-                ).get().getPlaceHolderPtr()->getVariableAddress()
-            );
-
-            // Extra-step for selecting the right dial with TClonesArray
-            if (not strcmp(dialObjectPtr->ClassName(), "TClonesArray")) {
-              dialObjectPtr = ((TClonesArray *) dialObjectPtr)->At(
-                  (dialIndexTreeFormula == nullptr ? 0 : int(dialIndexTreeFormula->EvalInstance()))
-              );
-            }
+        }
+        else {
+          LogThrow("neither an event by event dial, nor a binned dial");
+        }
 
-            // Do the unique_ptr dance so that memory gets deleted if
-            // there is an exception (being stupidly paranoid).
-            DialBaseFactory factory{};
-            std::unique_ptr<DialBase> dialBase(
-                factory.makeDial(
-                    dialCollectionRef->getTitle(),
-                    dialCollectionRef->getGlobalDialType(),
-                    dialCollectionRef->getGlobalDialSubType(),
-                    dialObjectPtr,
-                    false
-                )
-            );
-
-            // dialBase is valid -> store it
-            if (dialBase != nullptr) {
-              size_t freeSlotDial = dialCollectionRef->getNextDialFreeSlot();
-              dialBase->setAllowExtrapolation(dialCollectionRef->isAllowDialExtrapolation());
-              dialCollectionRef->getDialBaseList()[freeSlotDial] = DialCollection::DialBaseObject(
-                  dialBase.release());
+      } // dial collection loop
+    }
 
-              dialEntryPtr->collectionIndex = iCollection;
-              dialEntryPtr->interfaceIndex = freeSlotDial;
-              dialEntryPtr++;
-            }
-          }
-          else {
-            LogThrow("neither an event by event dial, nor a binned dial");
-          }
+  } // samples
 
-        } // dial collection loop
-      }
+  return true;
+}
+void DataDispenser::fillFunction(int iThread_, std::vector<DataDispenserFillBuffer>* fillBufferList_){
+
+  int nThreads = GundamGlobals::getParallelWorker().getNbThreads();
+  if( iThread_ == -1 ){ iThread_ = 0; nThreads = 1; } // special mode
+
+  DataDispenserEntryReader reader{};
+  this->initEntryReader( reader, iThread_ == 0 );
 
+  DataDispenserEventBuilder builder{};
+  this->initEventBuilder( builder, iThread_ == 0 );
+
+  // the events are built right after the entry is read
+  DataDispenserEntryBuffer entry{};
+  this->initEntryBuffer( entry, reader );
+
+  // the read ranges are pulled in entry order: the one of thread 0 tracks the progress
+  for( size_t iRange = _cache_.nextReadRangeIndex++ ; iRange < _cache_.readRangeList.size() ; iRange = _cache_.nextReadRangeIndex++ ){
+    for( size_t iChunk = _cache_.readRangeList[iRange].first ; iChunk < _cache_.readRangeList[iRange].second ; iChunk++ ){
+      auto& chunk = _cache_.entryChunkList[iChunk];
+      auto* fillBuffer = this->fetchFillBuffer( fillBufferList_, iChunk );
+
+      for( Long64_t iEntry = chunk.beginEntry ; iEntry < chunk.endEntry ; iEntry++ ){
+        if( iThread_ == 0 ){ this->printFillProgress( reader, iEntry, nThreads, nThreads ); }
+        if( not this->readEntry( reader, iEntry, chunk, fillBuffer, entry ) ){ continue; }
+        if( not this->buildEvents( builder, entry, chunk, fillBuffer, iThread_ == 0 ) ){ return; }
+      } // entries
+    } // chunks
+  } // read ranges
 
-    } // samples
-  } // entries
   if( iThread_ == 0 ){
-    GenericToolbox::displayProgressBar(nEvents, nEvents, ssProgressBar.str());
+    GenericToolbox::displayProgressBar(reader.nEntries, reader.nEntries, reader.ssProgressBar.str());
+  }
+
+}
+void DataDispenser::runFillPipeline(std::vector<DataDispenserFillBuffer>* fillBufferList_){
+  int nThreads{GundamGlobals::getParallelWorker().getNbThreads()};
+  int nReaderThreads{_owner_->getNbPipelineReaderThreads()};
+  int nWorkerThreads{_owner_->getNbPipelineWorkerThreads()};
+  if( nWorkerThreads == 0 ){ nWorkerThreads = nThreads - nReaderThreads; } // all the others
+
+  // the stages wait for each other: all their threads have to run at once
+  LogThrowIf(nReaderThreads < 1 or nWorkerThreads < 1 or nReaderThreads + nWorkerThreads > nThreads,
+             "Invalid loading pipeline: " << nReaderThreads << " reader and " << nWorkerThreads
+             << " worker threads for " << nThreads << " available threads.");
+
+  size_t nBatches{_owner_->getPipelineBufferSize()};
+  if( nBatches == 0 ){ nBatches = 4 * size_t(nWorkerThreads); }
+
+  LogInfo << "Pipelined loading: " << nReaderThreads << " reader thread(s) feeding " << nWorkerThreads
+          << " worker thread(s) through " << nBatches << " batches of " << _owner_->getPipelineBatchSize() << " entries." << std::endl;
+
+  DataDispenserPipeline pipeline{};
+  pipeline.initialize( nReaderThreads, nWorkerThreads, nBatches, _owner_->getPipelineBatchSize() );
+
+  auto startTime{std::chrono::steady_clock::now()};
+  GundamGlobals::getParallelWorker().addJob(__METHOD_NAME__, [&](int iThread_){
+    if     ( iThread_ < nReaderThreads ){ this->readerFunction( iThread_, pipeline, fillBufferList_ ); }
+    else if( iThread_ < nReaderThreads + nWorkerThreads ){ this->workerFunction( iThread_ - nReaderThreads, pipeline, fillBufferList_ ); }
+  });
+  GundamGlobals::getParallelWorker().runJob(__METHOD_NAME__);
+  GundamGlobals::getParallelWorker().removeJob(__METHOD_NAME__);
+
+  pipeline.printUtilisation( std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() );
+}
+void DataDispenser::readerFunction(int iReader_, DataDispenserPipeline& pipeline_, std::vector<DataDispenserFillBuffer>* fillBufferList_){
+  auto startTime{std::chrono::steady_clock::now()};
+  double waitTime{0};
+
+  DataDispenserPipeline::Batch* batch{nullptr};
+  try{
+    DataDispenserEntryReader reader{};
+    this->initEntryReader( reader, iReader_ == 0 );
+
+    int nThreads{pipeline_.readerMonitor.nThreads + pipeline_.workerMonitor.nThreads};
+    for( size_t iRange = _cache_.nextReadRangeIndex++ ; iRange < _cache_.readRangeList.size() ; iRange = _cache_.nextReadRangeIndex++ ){
+      for( size_t iChunk = _cache_.readRangeList[iRange].first ; iChunk < _cache_.readRangeList[iRange].second ; iChunk++ ){
+        auto& chunk = _cache_.entryChunkList[iChunk];
+        auto* fillBuffer = this->fetchFillBuffer( fillBufferList_, iChunk );
+
+        if( batch == nullptr ){
+          auto waitStartTime{std::chrono::steady_clock::now()};
+          batch = pipeline_.fetchFreeBatch();
+          waitTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStartTime).count();
+          if( batch == nullptr ){ return; } // aborted by a failing thread
+        }
+
+        // the event-by-event dials are built here: the branch objects are overwritten by the next GetEntry
+        batch->chunkIndex = iChunk;
+        batch->nEntries = 0;
+        for( Long64_t iEntry = chunk.beginEntry ; iEntry < chunk.endEntry ; iEntry++ ){
+          if( iReader_ == 0 ){ this->printFillProgress( reader, iEntry, pipeline_.readerMonitor.nThreads, nThreads ); }
+          auto& entry = batch->entryList[batch->nEntries];
+          if( entry.isInSampleList.empty() ){ this->initEntryBuffer( entry, reader ); }
+          if( this->readEntry( reader, iEntry, chunk, fillBuffer, entry ) ){ batch->nEntries++; }
+        }
+
+        // nothing selected: the batch is kept for the next chunk
+        if( batch->nEntries == 0 ){ continue; }
+        pipeline_.pushFilledBatch( batch );
+        batch = nullptr;
+      }
+    }
+
+    if( iReader_ == 0 ){
+      GenericToolbox::displayProgressBar(reader.nEntries, reader.nEntries, reader.ssProgressBar.str());
+    }
+  }
+  catch( ... ){
+    pipeline_.abort();
+    pipeline_.stopReader( batch, 0, 0 );
+    throw;
+  }
+
+  double runTime{std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count()};
+  pipeline_.stopReader( batch, runTime - waitTime, waitTime );
+}
+void DataDispenser::workerFunction(int iWorker_, DataDispenserPipeline& pipeline_, std::vector<DataDispenserFillBuffer>* fillBufferList_){
+  auto startTime{std::chrono::steady_clock::now()};
+  double waitTime{0};
+
+  try{
+    DataDispenserEventBuilder builder{};
+    this->initEventBuilder( builder, iWorker_ == 0 );
+
+    while( true ){
+      auto waitStartTime{std::chrono::steady_clock::now()};
+      auto* batch = pipeline_.fetchFilledBatch();
+      waitTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStartTime).count();
+      if( batch == nullptr ){ break; }
+
+      // one worker per chunk: its slots are not shared
+      auto& chunk = _cache_.entryChunkList[batch->chunkIndex];
+      auto* fillBuffer = this->fetchFillBuffer( fillBufferList_, batch->chunkIndex );
+      for( size_t iEntry = 0 ; iEntry < batch->nEntries ; iEntry++ ){
+        this->buildEvents( builder, batch->entryList[iEntry], chunk, fillBuffer, false );
+      }
+      pipeline_.releaseBatch( batch );
+    }
+  }
+  catch( ... ){
+    pipeline_.abort();
+    throw;
+  }
+
+  double runTime{std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count()};
+  pipeline_.stopWorker( runTime - waitTime, waitTime );
+}
+DataDispenserFillBuffer* DataDispenser::fetchFillBuffer(std::vector<DataDispenserFillBuffer>* fillBufferList_, size_t iChunk_){
+  if( fillBufferList_ == nullptr ){ return nullptr; }
+
+  // filled by one thread at a time: the one reading the chunk, then the one building its events
+  auto& fillBuffer = (*fillBufferList_)[iChunk_];
+  if( fillBuffer.sampleNbOfEvents.empty() ){
+    size_t nSample{_cache_.samplesToFillList.size()};
+    fillBuffer.sampleNbOfEvents.resize(nSample, 0);
+    fillBuffer.sampleEventList.resize(nSample);
+    fillBuffer.sampleCacheEntryList.resize(nSample);
+    fillBuffer.collectionNbOfEventDials.resize(_cache_.propagatorPtr->getDialCollectionList().size(), 0);
+  }
+  return &fillBuffer;
+}
+void DataDispenser::mergeFillBuffer(DataDispenserFillBuffer& fillBuffer_){
+  auto& dialCollectionList = _cache_.propagatorPtr->getDialCollectionList();
+  auto* cacheEntryPtr = fillBuffer_.cacheEntryPtr;
+
+  for( size_t iSample = 0 ; iSample < fillBuffer_.sampleEventList.size() ; iSample++ ){
+    size_t eventOffset{fillBuffer_.sampleEventOffsetList[iSample]};
+
+    auto& eventList = fillBuffer_.sampleEventList[iSample];
+    std::move( eventList.begin(), eventList.end(), _cache_.sampleEventListPtrToFill[iSample]->begin() + long(eventOffset) );
+    eventList = std::vector<Event>(); // release the memory right away
+
+    for( auto& cacheEntry : fillBuffer_.sampleCacheEntryList[iSample] ){
+      cacheEntry.event.eventIndex += eventOffset;
+      for( auto& dialEntry : cacheEntry.dials ){
+        if( dialEntry.collectionIndex == size_t(-1) ){ break; } // unused slots are at the end
+        auto& dialCollection = dialCollectionList[dialEntry.collectionIndex];
+        if( dialCollection.isBinned() ){ continue; }
+        dialEntry.interfaceIndex = dialCollection.storeEventDial( std::move( fillBuffer_.eventDialList[dialEntry.interfaceIndex] ) );
+      }
+      *(cacheEntryPtr++) = std::move( cacheEntry );
+    }
+    fillBuffer_.sampleCacheEntryList[iSample] = std::vector<EventDialCache::IndexedCacheEntry>();
   }
 
+  fillBuffer_.eventDialList.clear();
 }
 
 //  A Lesser GNU Public License
@@ -5,6 +5,7 @@
 #include "DataDispenserUtils.h"
 
 #include "GenericToolbox.Map.h"
+#include "GenericToolbox.Utils.h"
 #include "Logger.h"
 
 #include "sstream"
@@ -32,9 +33,18 @@ std::string DataDispenserParameters::getSummary() const{
 void DataDispenserCache::clear(){
   propagatorPtr = nullptr;
 
+  isSinglePassLoading = false;
+  isPipelinedLoading = false;
+  totalNbEvents = 0;
+  eventPlaceholder = Event();
+
   samplesToFillList.clear();
   sampleNbOfEvents.clear();
-  eventIsInSamplesList.clear();
+  selectionBitmap.clear();
+  entryChunkList.clear();
+  nextChunkIndex.setValue(0);
+  readRangeList.clear();
+  nextReadRangeIndex.setValue(0);
 
   sampleIndexOffsetList.clear();
   sampleEventListPtrToFill.clear();
@@ -58,3 +68,104 @@ void DataDispenserCache::addVarRequestedForStorage(const std::string& varName_){
 }
 
 
+void DataDispenserPipeline::initialize(int nReaderThreads_, int nWorkerThreads_, size_t nBatches_, size_t batchSize_){
+  LogThrowIf(nReaderThreads_ < 1 or nWorkerThreads_ < 1, "The pipeline needs at least one reader and one worker thread.");
+  LogThrowIf(nBatches_ == 0 or batchSize_ == 0, "Invalid pipeline buffer size.");
+
+  isAborted = false;
+  readerMonitor.nThreads = nReaderThreads_;
+  workerMonitor.nThreads = nWorkerThreads_;
+  nRunningReaders = nReaderThreads_;
+
+  batchList.clear();
+  batchList.resize(nBatches_);
+  freeBatchList.clear();
+  filledBatchList.clear();
+  for( auto& batch : batchList ){
+    batch.entryList.resize(batchSize_);
+    freeBatchList.emplace_back(&batch);
+  }
+}
+
+DataDispenserPipeline::Batch* DataDispenserPipeline::fetchFreeBatch(){
+  std::unique_lock<std::mutex> lock(mutex);
+  freeBatchCondition.wait(lock, [this]{ return not freeBatchList.empty() or isAborted; });
+  if( isAborted ){ return nullptr; }
+  auto* out = freeBatchList.front();
+  freeBatchList.pop_front();
+  return out;
+}
+void DataDispenserPipeline::pushFilledBatch(Batch* batch_){
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    filledBatchList.emplace_back(batch_);
+  }
+  filledBatchCondition.notify_one();
+}
+void DataDispenserPipeline::stopReader(Batch* unusedBatch_, double busyTime_, double waitTime_){
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if( unusedBatch_ != nullptr ){ freeBatchList.emplace_back(unusedBatch_); }
+    readerMonitor.busyTime += busyTime_;
+    readerMonitor.waitTime += waitTime_;
+    nRunningReaders--;
+  }
+  // the workers waiting on an empty ring have to check if they are done
+  freeBatchCondition.notify_one();
+  filledBatchCondition.notify_all();
+}
+
+DataDispenserPipeline::Batch* DataDispenserPipeline::fetchFilledBatch(){
+  std::unique_lock<std::mutex> lock(mutex);
+  filledBatchCondition.wait(lock, [this]{ return not filledBatchList.empty() or nRunningReaders == 0 or isAborted; });
+  if( filledBatchList.empty() or isAborted ){ return nullptr; }
+  auto* out = filledBatchList.front();
+  filledBatchList.pop_front();
+  return out;
+}
+void DataDispenserPipeline::releaseBatch(Batch* batch_){
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeBatchList.emplace_back(batch_);
+  }
+  freeBatchCondition.notify_one();
+}
+void DataDispenserPipeline::stopWorker(double busyTime_, double waitTime_){
+  std::lock_guard<std::mutex> lock(mutex);
+  workerMonitor.busyTime += busyTime_;
+  workerMonitor.waitTime += waitTime_;
+}
+
+void DataDispenserPipeline::abort(){
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    isAborted = true;
+  }
+  freeBatchCondition.notify_all();
+  filledBatchCondition.notify_all();
+}
+
+void DataDispenserPipeline::printUtilisation(double wallTime_) const{
+  LogInfo << "Loading pipeline utilisation:" << std::endl;
+  GenericToolbox::TablePrinter t;
+  t.setColTitles({{"Stage"}, {"# of threads"}, {"Busy"}, {"Waiting"}});
+  auto addLine = [&](const std::string& name_, const StageMonitor& monitor_){
+    // per thread: relative to the wall time of the fill
+    double busyFraction{wallTime_ > 0 ? monitor_.busyTime / (monitor_.nThreads * wallTime_) : 0};
+    double waitFraction{wallTime_ > 0 ? monitor_.waitTime / (monitor_.nThreads * wallTime_) : 0};
+    t.addTableLine({
+      name_, std::to_string(monitor_.nThreads),
+      std::to_string(int(100 * busyFraction)) + "%", std::to_string(int(100 * waitFraction)) + "%"
+    });
+  };
+  addLine("Readers", readerMonitor);
+  addLine("Workers", workerMonitor);
+  t.printTable();
+
+  if( readerMonitor.waitTime / readerMonitor.nThreads > workerMonitor.waitTime / workerMonitor.nThreads ){
+    LogInfo << "Readers were waiting for free buffers: more worker threads would help." << std::endl;
+  }
+  else{
+    LogInfo << "Workers were waiting for entries: more reader threads would help." << std::endl;
+  }
+}
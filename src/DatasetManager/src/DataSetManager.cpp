@@ -101,15 +101,14 @@ void DataSetManager::loadData(){
         if( _propagator_.isDebugPrintLoadedEvents() ){
           LogDebug << "Toy events:" << std::endl;
           LogDebug << GET_VAR_NAME_VALUE(_propagator_.getDebugPrintLoadedEventsNbPerSample()) << std::endl;
-          int iEvt{0};
-          for( auto& entry : _propagator_.getEventDialCache().getCache() ) {
-            LogDebug << "Event #" << iEvt++ << "{" << std::endl;
+          for( size_t iEvt = 0 ; iEvt < _propagator_.getEventDialCache().getNbEntries() ; iEvt++ ) {
+            if( iEvt >= size_t(_propagator_.getDebugPrintLoadedEventsNbPerSample()) ) break;
+            LogDebug << "Event #" << iEvt << "{" << std::endl;
             {
               LogScopeIndent;
-              LogDebug << entry.getSummary() << std::endl;
+              LogDebug << _propagator_.getEventDialCache().getEntrySummary(iEvt) << std::endl;
             }
             LogDebug << "}" << std::endl;
-            if( iEvt >= _propagator_.getDebugPrintLoadedEventsNbPerSample() ) break;
           }
         }
       }
@@ -51,6 +51,13 @@ void DatasetDefinition::readConfigImpl() {
   _devSingleThreadEventLoaderAndIndexer_ = GenericToolbox::Json::fetchValue(_config_, "devSingleThreadEventLoaderAndIndexer", _devSingleThreadEventLoaderAndIndexer_);
   _devSingleThreadEventSelection_ = GenericToolbox::Json::fetchValue(_config_, "devSingleThreadEventSelection", _devSingleThreadEventSelection_);
   _sortLoadedEvents_ = GenericToolbox::Json::fetchValue(_config_, "sortLoadedEvents", _sortLoadedEvents_);
+  _singlePassLoading_ = GenericToolbox::Json::fetchValue(_config_, "singlePassLoading", _singlePassLoading_);
+  _pipelinedLoading_ = GenericToolbox::Json::fetchValue(_config_, "pipelinedLoading", _pipelinedLoading_);
+  _nPipelineReaderThreads_ = GenericToolbox::Json::fetchValue(_config_, "nPipelineReaderThreads", _nPipelineReaderThreads_);
+  _nPipelineWorkerThreads_ = GenericToolbox::Json::fetchValue(_config_, "nPipelineWorkerThreads", _nPipelineWorkerThreads_);
+  _pipelineBufferSize_ = GenericToolbox::Json::fetchValue(_config_, "pipelineBufferSize", _pipelineBufferSize_);
+  _pipelineBatchSize_ = GenericToolbox::Json::fetchValue(_config_, "pipelineBatchSize", _pipelineBatchSize_);
+  LogThrowIf(_pipelineBatchSize_ == 0, "pipelineBatchSize should be positive.");
 
 }
 void DatasetDefinition::initializeImpl() {
@@ -52,8 +52,15 @@ void EventTreeWriter::writeSamples(TDirectory* saveDir_, const Propagator& propa
     for( bool isData : {false, true} ) {
       const auto *evListPtr = (isData ? &sample.getDataContainer().getEventList() : &sample.getMcContainer().getEventList());
       if (evListPtr->empty()) continue;
+      sampleElementPtr = (isData ? &sample.getDataContainer() : &sample.getMcContainer());
 
-      if( not _writeDials_ or isData ){
+      bool writeDials{_writeDials_ and not isData};
+      if( writeDials and propagator_.getEventDialCache().isUseCompressedCache() ){
+        LogAlert << "Can't write dials with the compressed dial cache. Writing events only." << std::endl;
+        writeDials = false;
+      }
+
+      if( not writeDials ){
         this->writeEvents(GenericToolbox::mkdirTFile(saveDir_, sample.getName()), (isData ? "Data" : "MC"), *evListPtr);
       }
       else{
@@ -70,6 +77,7 @@ void EventTreeWriter::writeSamples(TDirectory* saveDir_, const Propagator& propa
       }
     } // isData
   } // sample
+  sampleElementPtr = nullptr;
 
 }
 void EventTreeWriter::writeEvents(TDirectory *saveDir_, const std::string& treeName_, const std::vector<Event> & eventList_) const {
@@ -99,7 +107,9 @@ template<typename T> void EventTreeWriter::writeEventsTemplate(TDirectory* saveD
 
   GenericToolbox::RawDataArray privateMemberArr;
   std::map<std::string, std::function<void(GenericToolbox::RawDataArray&, const Event&)>> leafDictionary;
-  leafDictionary["eventWeight/D"] =   [](GenericToolbox::RawDataArray& arr_, const Event& ev_){ arr_.writeRawData(ev_.getWeights().current); };
+  leafDictionary["eventWeight/D"] =   [this](GenericToolbox::RawDataArray& arr_, const Event& ev_){
+    arr_.writeRawData( sampleElementPtr != nullptr ? sampleElementPtr->getEventWeight(ev_) : ev_.getWeights().current );
+  };
   leafDictionary["treeWeight/D"] =    [](GenericToolbox::RawDataArray& arr_, const Event& ev_){ arr_.writeRawData(ev_.getWeights().base); };
   leafDictionary["sampleBinIndex/I"]= [](GenericToolbox::RawDataArray& arr_, const Event& ev_){ arr_.writeRawData(ev_.getIndices().bin); };
   leafDictionary["dataSetIndex/I"] =  [](GenericToolbox::RawDataArray& arr_, const Event& ev_){ arr_.writeRawData(ev_.getIndices().dataset); };
@@ -234,7 +244,7 @@ template<typename T> void EventTreeWriter::writeEventsTemplate(TDirectory* saveD
             DialInputBuffer inputBuf{*dial.dialInterface.getInputBufferRef()};
             grPtr->RemovePoint(0); // remove the first and recreate the whole thing
             for( double xPoint : parameterXvalues[iGlobalPar] ){
-              inputBuf.getInputBuffer()[0] = xPoint;
+              inputBuf.setInputValue(0, xPoint);
               grPtr->AddPoint(
                   xPoint,
                   DialInterface::evalResponse(
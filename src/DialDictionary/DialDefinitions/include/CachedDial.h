@@ -7,23 +7,37 @@
 
 #include "DialInputBuffer.h"
 
+#include <atomic>
+#include <cstdint>
+
 /// This is a template to add caching to a DialBase derived class.
+///
+/// The cache is lock-free: the response is stored along with the epoch of
+/// the DialInputBuffer it has been computed with. The state word packs the
+/// epoch (48 bits) and a write sequence (16 bits, odd while a thread is
+/// writing) such that readers can detect a concurrent write (seqlock). Only
+/// one thread publishes a new response, the others return the value they
+/// computed themselves.
 template <typename T> class CachedDial: public T {
 public:
   CachedDial() = default;
+
+  // the cache is not copied
+  CachedDial(const CachedDial& other_): T(other_) {}
+  CachedDial& operator=(const CachedDial& other_){ T::operator=(other_); this->resetCache(); return *this; }
+  CachedDial(CachedDial&& other_) noexcept : T(std::move(other_)) {}
+  CachedDial& operator=(CachedDial&& other_) noexcept { T::operator=(std::move(other_)); this->resetCache(); return *this; }
+
   double evalResponse(const DialInputBuffer& input_) const override;
   bool isCacheValid(const DialInputBuffer& input_) const;
-  void updateInputCache(const DialInputBuffer& input_) const;
+  void resetCache() const;
 
 protected:
-  mutable double _cachedResponse_{std::nan("unset")}; // + 8 bytes
-  mutable GenericToolbox::NoCopyWrapper<std::mutex> _evalLock_{}; // + 64 bytes
-#if USE_ZLIB
-  // + 4 bytes (keeping a vector empty is already 24...)
-  mutable uint32_t _cachedInputHash_{0};
-#else
-  mutable std::vector<double> _cachedInputs_{}; // + 24 bytes
-#endif
+  static constexpr int sequenceBits{16};
+  static constexpr uint64_t sequenceMask{(uint64_t(1) << sequenceBits) - 1};
+
+  mutable std::atomic<double> _cachedResponse_{std::nan("unset")}; // + 8 bytes
+  mutable std::atomic<uint64_t> _cacheState_{0}; // + 8 bytes: epoch << 16 | sequence
 };
 
 
@@ -8,37 +8,38 @@
 #include "CachedDial.h"
 
 template <typename T> double CachedDial<T>::evalResponse(const DialInputBuffer& input_) const {
-  if (isCacheValid(input_)) {return _cachedResponse_;}
-  #if HAS_CPP_17
-  std::scoped_lock<std::mutex> g(_evalLock_);
-  #else
-  std::lock_guard<std::mutex> g(_evalLock_);
-  #endif
-  if (isCacheValid(input_)) {return _cachedResponse_;}
-  _cachedResponse_ = this->T::evalResponse(input_);
-  updateInputCache(input_);
-  return _cachedResponse_;
+  const uint64_t epoch{input_.getEpoch() & (~uint64_t(0) >> sequenceBits)};
+
+  // reader side of the seqlock
+  uint64_t state{_cacheState_.load(std::memory_order_acquire)};
+  if( (state >> sequenceBits) == epoch ){
+    double response{_cachedResponse_.load(std::memory_order_relaxed)};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if( _cacheState_.load(std::memory_order_relaxed) == state ){ return response; }
+  }
+
+  double response{this->T::evalResponse(input_)};
+
+  // writer side: skip if another thread is already writing
+  if( (state & 1) == 0 ){
+    uint64_t sequence{state & sequenceMask};
+    if( _cacheState_.compare_exchange_strong(
+        state, (sequence + 1) & sequenceMask, std::memory_order_acq_rel, std::memory_order_relaxed) ){
+      std::atomic_thread_fence(std::memory_order_release);
+      _cachedResponse_.store(response, std::memory_order_relaxed);
+      _cacheState_.store((epoch << sequenceBits) | ((sequence + 2) & sequenceMask), std::memory_order_release);
+    }
+  }
+  return response;
 }
 template <typename T> bool CachedDial<T>::isCacheValid(const DialInputBuffer& input_) const {
-#if USE_ZLIB
-  return _cachedInputHash_ == input_.getCurrentHash();
-#else
-  if( _cachedInputs_.size() != input_.getBufferSize() ) return false;
-  return ( memcmp(
-             _cachedInputs_.data(), input_.getInputBuffer().data(),
-             input_.getBufferSize() * sizeof(*input_.getInputBuffer().data())) == 0 );
-#endif
+  const uint64_t epoch{input_.getEpoch() & (~uint64_t(0) >> sequenceBits)};
+  return (_cacheState_.load(std::memory_order_acquire) >> sequenceBits) == epoch;
 }
-template <typename T> void CachedDial<T>::updateInputCache(const DialInputBuffer& input_) const {
-#if USE_ZLIB
-  _cachedInputHash_ = input_.getCurrentHash();
-#else
-  if( _cachedInputs_.size() != input_.getBufferSize() ){
-    _cachedInputs_.resize(input_.getBufferSize(), std::nan("unset"));
-  }
-  memcpy(_cachedInputs_.data(), input_.getInputBuffer().data(),
-         input_.getBufferSize() * sizeof(*input_.getInputBuffer().data()));
-#endif
+template <typename T> void CachedDial<T>::resetCache() const {
+  // epoch 0 is never used by an input buffer
+  _cachedResponse_.store(std::nan("unset"), std::memory_order_relaxed);
+  _cacheState_.store(0, std::memory_order_release);
 }
 
 #endif //GUNDAM_CACHEDDIAL_IMPL_H
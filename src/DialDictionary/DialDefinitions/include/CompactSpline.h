@@ -6,22 +6,38 @@
 #define GUNDAM_COMPACTSPLINE_H
 
 #include "DialBase.h"
+#include "CalculateCompactSpline.h"
 #include "DialInputBuffer.h"
 
 #include "TGraph.h"
 
+#include <cmath>
 #include <vector>
+#include <stdexcept>
 #include <utility>
 
 class CompactSpline : public DialBase {
 
 public:
   CompactSpline() = default;
-  ~CompactSpline() override = default;
 
   [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<CompactSpline>(*this); }
   [[nodiscard]] std::string getDialTypeName() const override { return {"CompactSpline"}; }
-  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override;
+  /// Defined in the header: inlined by the devirtualized evaluation loops
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    double dialInput{input_.getInputBuffer()[0]};
+
+#ifndef NDEBUG
+    if( not std::isfinite(dialInput) ){ throw std::runtime_error("Invalid input for CompactSpline"); }
+#endif
+
+    if( not _allowExtrapolation_ ){
+      if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
+      else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
+    }
+
+    return CalculateCompactSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()-2) );
+  }
 
   [[nodiscard]] std::string getSummary() const override;
 
@@ -43,6 +59,7 @@ public:
                          const std::string& option_="") override;
 
   [[nodiscard]] const std::vector<double>& getDialData() const override {return _splineData_;}
+  [[nodiscard]] const std::pair<double, double>& getSplineBounds() const { return _splineBounds_; }
 
 protected:
   bool _allowExtrapolation_{false};
@@ -0,0 +1,128 @@
+#ifndef GUNDAM_FLOAT_KNOT_SPLINE_H
+#define GUNDAM_FLOAT_KNOT_SPLINE_H
+
+#include "DialBase.h"
+#include "CompactSpline.h"
+#include "MonotonicSpline.h"
+#include "UniformSpline.h"
+#include "GeneralSpline.h"
+
+#include <cmath>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+
+
+/// Single precision storage of the event-by-event splines. The data block is
+/// the one of the double precision dial rounded to float, which halves the
+/// memory taken by the knots. The responses are still computed in double
+/// precision by the same Calculate*Spline functions.
+///
+/// The knots are held in a bare array rather than a vector: the memory
+/// footprint is the whole point of this class. They can be moved to an
+/// external buffer, so the DialArena can pack the knots of a pool together.
+class FloatKnotSplineBase : public DialBase {
+
+public:
+  FloatKnotSplineBase() = default;
+
+  // deep copy of the knots
+  FloatKnotSplineBase(const FloatKnotSplineBase& other_);
+  FloatKnotSplineBase& operator=(const FloatKnotSplineBase& other_);
+  FloatKnotSplineBase(FloatKnotSplineBase&& other_) noexcept = default;
+  FloatKnotSplineBase& operator=(FloatKnotSplineBase&& other_) noexcept = default;
+
+  void setAllowExtrapolation(bool allowExtrapolation_) override { _allowExtrapolation_ = allowExtrapolation_; }
+  [[nodiscard]] bool getAllowExtrapolation() const override { return _allowExtrapolation_; }
+  [[nodiscard]] std::string getSummary() const override;
+
+  [[nodiscard]] const float* getKnotData() const { return _knotData_; }
+  [[nodiscard]] size_t getKnotDataSize() const { return _knotDataSize_; }
+  [[nodiscard]] const std::pair<double, double>& getSplineBounds() const { return _splineBounds_; }
+
+  /// Copy the knots to buffer_ (getKnotDataSize() floats) and use them from
+  /// there. The buffer is not owned: it has to outlive the dial.
+  void moveKnotData(float* buffer_);
+
+  /// Single precision version of a CompactSpline, MonotonicSpline,
+  /// UniformSpline or GeneralSpline. Returns nullptr for any other type,
+  /// including the cached variants.
+  static std::unique_ptr<FloatKnotSplineBase> makeFloatKnotSpline(const DialBase& dialBase_);
+
+  /// Largest absolute difference between the responses of two dials,
+  /// sampled at nSamples_ points evenly spread over bounds_.
+  static double getMaxDeviation(const DialBase& dialA_, const DialBase& dialB_,
+                                const std::pair<double, double>& bounds_, int nSamples_ = 16);
+
+protected:
+  void setKnotData(const std::vector<double>& splineData_, const std::pair<double, double>& splineBounds_);
+
+  [[nodiscard]] double getClampedInput(const DialInputBuffer& input_) const {
+    double dialInput{input_.getInputBuffer()[0]};
+
+#ifndef NDEBUG
+    if( not std::isfinite(dialInput) ){ throw std::runtime_error("Invalid input for " + this->getDialTypeName()); }
+#endif
+
+    if( not _allowExtrapolation_ ){
+      if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
+      else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
+    }
+    return dialInput;
+  }
+
+  bool _allowExtrapolation_{false};
+  uint32_t _knotDataSize_{0};
+  const float* _knotData_{nullptr}; // _ownedKnotData_ or an external buffer
+  std::unique_ptr<float[]> _ownedKnotData_{nullptr};
+  std::pair<double, double> _splineBounds_{std::nan("unset"), std::nan("unset")};
+};
+
+
+/// T is the double precision spline the data block comes from. The
+/// evaluation is specialised for each of them below.
+template<typename T> class FloatKnotSpline : public FloatKnotSplineBase {
+
+public:
+  FloatKnotSpline() = default;
+  explicit FloatKnotSpline(const T& spline_){
+    this->setKnotData( spline_.getDialData(), spline_.getSplineBounds() );
+    _allowExtrapolation_ = spline_.getAllowExtrapolation();
+  }
+
+  [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<FloatKnotSpline<T>>(*this); }
+  [[nodiscard]] std::string getDialTypeName() const override;
+  /// Defined in the header: inlined by the devirtualized evaluation loops
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override { return this->evalKnotData( this->getClampedInput(input_) ); }
+
+  [[nodiscard]] double evalKnotData(double dialInput_) const;
+};
+
+typedef FloatKnotSpline<CompactSpline> CompactSplineFloat;
+typedef FloatKnotSpline<MonotonicSpline> MonotonicSplineFloat;
+typedef FloatKnotSpline<UniformSpline> UniformSplineFloat;
+typedef FloatKnotSpline<GeneralSpline> GeneralSplineFloat;
+
+template<> inline std::string CompactSplineFloat::getDialTypeName() const { return {"CompactSplineFloat"}; }
+template<> inline std::string MonotonicSplineFloat::getDialTypeName() const { return {"MonotonicSplineFloat"}; }
+template<> inline std::string UniformSplineFloat::getDialTypeName() const { return {"UniformSplineFloat"}; }
+template<> inline std::string GeneralSplineFloat::getDialTypeName() const { return {"GeneralSplineFloat"}; }
+
+// same calls as in the double precision dials
+template<> inline double CompactSplineFloat::evalKnotData(double dialInput_) const {
+  return CalculateCompactSpline( dialInput_, -1E20, 1E20, _knotData_, int(_knotDataSize_-2) );
+}
+template<> inline double MonotonicSplineFloat::evalKnotData(double dialInput_) const {
+  return CalculateMonotonicSpline( dialInput_, -1E20, 1E20, _knotData_, int(_knotDataSize_-2) );
+}
+template<> inline double UniformSplineFloat::evalKnotData(double dialInput_) const {
+  return CalculateUniformSpline( dialInput_, -1E20, 1E20, _knotData_, int(_knotDataSize_) );
+}
+template<> inline double GeneralSplineFloat::evalKnotData(double dialInput_) const {
+  return CalculateGeneralSpline( dialInput_, -1E20, 1E20, _knotData_, int(_knotDataSize_) );
+}
+
+
+#endif //GUNDAM_FLOAT_KNOT_SPLINE_H
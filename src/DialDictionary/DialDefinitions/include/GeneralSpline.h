@@ -6,12 +6,15 @@
 #define GUNDAM_GENERALSPLINE_H
 
 #include "DialBase.h"
+#include "CalculateGeneralSpline.h"
 #include "DialInputBuffer.h"
 
 #include "TGraph.h"
 #include "TSpline.h"
 
+#include <cmath>
 #include <vector>
+#include <stdexcept>
 #include <utility>
 
 
@@ -22,7 +25,17 @@ public:
 
   [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<GeneralSpline>(*this); }
   [[nodiscard]] std::string getDialTypeName() const override { return {"GeneralSpline"}; }
-  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override;
+  /// Defined in the header: inlined by the devirtualized evaluation loops
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    double dialInput{input_.getInputBuffer()[0]};
+
+    if( not _allowExtrapolation_ ){
+      if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
+      else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
+    }
+
+    return CalculateGeneralSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()) );
+  }
 
   void setAllowExtrapolation(bool allowExtrapolation) override;
   [[nodiscard]] bool getAllowExtrapolation() const override;
@@ -39,6 +52,7 @@ public:
                          const std::string& option_="") override;
 
    const std::vector<double>& getDialData() const override {return _splineData_;}
+   [[nodiscard]] const std::pair<double, double>& getSplineBounds() const { return _splineBounds_; }
 
 protected:
   bool _allowExtrapolation_{false};
@@ -6,10 +6,13 @@
 #define GUNDAM_LIGHTGRAPH_H
 
 #include "DialBase.h"
+#include "CalculateGraph.h"
 
 #include "TGraph.h"
 
+#include <cmath>
 #include <vector>
+#include <stdexcept>
 
 
 /// A DialBase class to do piecewise linear interpolation.  This is
@@ -22,7 +25,21 @@ public:
 
   [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<LightGraph>(*this); }
   [[nodiscard]] std::string getDialTypeName() const override { return {"LightGraph"}; }
-  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override;
+  /// Defined in the header: inlined by the devirtualized evaluation loops
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    double dialInput{input_.getInputBuffer()[0]};
+
+#ifndef NDEBUG
+    if( not std::isfinite(dialInput) ){ throw std::runtime_error("Invalid input for LightGraph"); }
+#endif
+
+    if( not _allowExtrapolation_ ){
+      if     (dialInput <= _Data_[1])     { return _Data_[0]; }
+      else if(dialInput >= _Data_.back()) { return _Data_[_Data_.size()-2]; }
+    }
+
+    return CalculateGraph(dialInput,-1E20,1E20,_Data_.data(),_Data_.size());
+  }
 
   void setAllowExtrapolation(bool allowExtrapolation) override;
   [[nodiscard]] bool getAllowExtrapolation() const override;
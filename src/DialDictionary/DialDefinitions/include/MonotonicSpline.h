@@ -6,22 +6,38 @@
 #define GUNDAM_MONOTONICSPLINE_H
 
 #include "DialBase.h"
+#include "CalculateMonotonicSpline.h"
 #include "DialInputBuffer.h"
 
 #include "TGraph.h"
 
+#include <cmath>
 #include <vector>
+#include <stdexcept>
 #include <utility>
 
 class MonotonicSpline : public DialBase {
 
 public:
   MonotonicSpline() = default;
-  ~MonotonicSpline() override = default;
 
   [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<MonotonicSpline>(*this); }
   [[nodiscard]] std::string getDialTypeName() const override { return {"MonotonicSpline"}; }
-  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override;
+  /// Defined in the header: inlined by the devirtualized evaluation loops
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    double dialInput{input_.getInputBuffer()[0]};
+
+#ifndef NDEBUG
+    if( not std::isfinite(dialInput) ){ throw std::runtime_error("Invalid input for MonotonicSpline"); }
+#endif
+
+    if( not _allowExtrapolation_ ){
+      if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
+      else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
+    }
+
+    return CalculateMonotonicSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()-2) );
+  }
 
   void setAllowExtrapolation(bool allowExtrapolation) override;
   [[nodiscard]] bool getAllowExtrapolation() const override;
@@ -38,6 +54,7 @@ public:
                          const std::string& option_="") override;
 
   [[nodiscard]] const std::vector<double>& getDialData() const override {return _splineData_;}
+  [[nodiscard]] const std::pair<double, double>& getSplineBounds() const { return _splineBounds_; }
 
 protected:
   bool _allowExtrapolation_{false};
@@ -0,0 +1,68 @@
+#ifndef GUNDAM_TABULATED_DIAL_H
+#define GUNDAM_TABULATED_DIAL_H
+
+#include "DialBase.h"
+
+#include <cmath>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+
+/// Response of a one-parameter dial sampled on a uniform grid. The
+/// evaluation is an index computation plus a linear interpolation, whatever
+/// the original dial was. Inputs out of the grid get the response of the
+/// closest edge: the grid is expected to cover everything the input can
+/// reach (parameter limits, or the bounds of a non-extrapolated spline).
+class TabulatedDial : public DialBase {
+
+public:
+  TabulatedDial() = default;
+
+  // deep copy of the table
+  TabulatedDial(const TabulatedDial& other_);
+  TabulatedDial& operator=(const TabulatedDial& other_);
+  TabulatedDial(TabulatedDial&& other_) noexcept = default;
+  TabulatedDial& operator=(TabulatedDial&& other_) noexcept = default;
+
+  [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<TabulatedDial>(*this); }
+  [[nodiscard]] std::string getDialTypeName() const override { return {"Tabulated"}; }
+  /// Defined in the header: inlined by the devirtualized evaluation loops
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    double position{(input_.getInputBuffer()[0] - _range_.first) * _invStep_};
+    if( not (position > 0) ){ return _responseTable_[0]; } // NaN included
+    uint32_t iPoint{uint32_t(position)};
+    if( iPoint >= _nPoints_ - 1 ){ return _responseTable_[_nPoints_ - 1]; }
+    double fraction{position - iPoint};
+    return _responseTable_[iPoint] + fraction * (double(_responseTable_[iPoint + 1]) - _responseTable_[iPoint]);
+  }
+
+  [[nodiscard]] std::string getSummary() const override;
+
+  [[nodiscard]] const float* getResponseTable() const { return _responseTable_; }
+  [[nodiscard]] size_t getNbPoints() const { return _nPoints_; }
+  [[nodiscard]] const std::pair<double, double>& getRange() const { return _range_; }
+
+  /// Copy the table to buffer_ (getNbPoints() floats) and use it from there.
+  /// The buffer is not owned: it has to outlive the dial.
+  void moveResponseTable(float* buffer_);
+
+  /// Sample dialBase_ with nPoints_ points over range_. maxDeviation_ is set
+  /// to the largest difference with the original dial, checked half way
+  /// between the points where the linear interpolation is the least
+  /// accurate. Returns nullptr if the range is not finite.
+  static std::unique_ptr<TabulatedDial> makeTabulatedDial(const DialBase& dialBase_, const std::pair<double, double>& range_,
+                                                          int nPoints_, double& maxDeviation_);
+
+private:
+  uint32_t _nPoints_{0};
+  double _invStep_{0};
+  std::pair<double, double> _range_{std::nan("unset"), std::nan("unset")};
+  // float: the interpolation error is way above the rounding
+  const float* _responseTable_{nullptr}; // _ownedResponseTable_ or an external buffer
+  std::unique_ptr<float[]> _ownedResponseTable_{nullptr};
+};
+
+
+#endif //GUNDAM_TABULATED_DIAL_H
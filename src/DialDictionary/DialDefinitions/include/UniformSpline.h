@@ -6,12 +6,15 @@
 #define GUNDAM_UNIFORMSPLINE_H
 
 #include "DialBase.h"
+#include "CalculateUniformSpline.h"
 #include "DialInputBuffer.h"
 
 #include "TGraph.h"
 #include "TSpline.h"
 
+#include <cmath>
 #include <vector>
+#include <stdexcept>
 #include <utility>
 
 
@@ -19,11 +22,24 @@ class UniformSpline : public DialBase {
 
 public:
   UniformSpline() = default;
-  ~UniformSpline() override = default;
 
   [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<UniformSpline>(*this); }
   [[nodiscard]] std::string getDialTypeName() const override { return {"UniformSpline"}; }
-  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override;
+  /// Defined in the header: inlined by the devirtualized evaluation loops
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    double dialInput{input_.getInputBuffer()[0]};
+
+#ifndef NDEBUG
+    if( not std::isfinite(dialInput) ){ throw std::runtime_error("Invalid input for UniformSpline"); }
+#endif
+
+    if( not _allowExtrapolation_ ){
+      if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
+      else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
+    }
+
+    return CalculateUniformSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()) );
+  }
 
   void setAllowExtrapolation(bool allowExtrapolation) override;
   [[nodiscard]] bool getAllowExtrapolation() const override;
@@ -40,6 +56,7 @@ public:
                          const std::string& option_="") override;
 
    const std::vector<double>& getDialData() const override {return _splineData_;}
+   [[nodiscard]] const std::pair<double, double>& getSplineBounds() const { return _splineBounds_; }
 
 protected:
   bool _allowExtrapolation_{false};
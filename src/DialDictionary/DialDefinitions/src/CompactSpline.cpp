@@ -112,22 +112,6 @@ void CompactSpline::buildDial(const std::vector<double>& v1,
 
 }
 
-double CompactSpline::evalResponse(const DialInputBuffer& input_) const {
-  double dialInput{input_.getInputBuffer()[0]};
-
-#ifndef NDEBUG
-  LogThrowIf(not std::isfinite(dialInput), "Invalid input for CompactSpline");
-#endif
-
-  if( not _allowExtrapolation_ ){
-    if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
-    else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
-  }
-
-  return CalculateCompactSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()-2) );
-}
-
-
 std::string CompactSpline::getSummary() const {
   std::stringstream ss;
   ss << this->getDialTypeName() << ": spline data = " << GenericToolbox::toString(_splineData_);
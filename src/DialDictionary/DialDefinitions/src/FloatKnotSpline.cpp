@@ -0,0 +1,82 @@
+#include "FloatKnotSpline.h"
+
+#include "GenericToolbox.Utils.h"
+#include "Logger.h"
+
+#include <sstream>
+#include <typeinfo>
+#include <algorithm>
+#include <limits>
+
+LoggerInit([]{
+  Logger::setUserHeaderStr("[FloatKnotSpline]");
+});
+
+
+FloatKnotSplineBase::FloatKnotSplineBase(const FloatKnotSplineBase& other_) : DialBase(other_) {
+  *this = other_;
+}
+FloatKnotSplineBase& FloatKnotSplineBase::operator=(const FloatKnotSplineBase& other_){
+  if( this == &other_ ){ return *this; }
+  _allowExtrapolation_ = other_._allowExtrapolation_;
+  _splineBounds_ = other_._splineBounds_;
+  _knotDataSize_ = other_._knotDataSize_;
+  _knotData_ = nullptr;
+  _ownedKnotData_.reset();
+  if( _knotDataSize_ != 0 ){
+    _ownedKnotData_ = std::unique_ptr<float[]>( new float[_knotDataSize_] );
+    std::copy( other_._knotData_, other_._knotData_ + _knotDataSize_, _ownedKnotData_.get() );
+    _knotData_ = _ownedKnotData_.get();
+  }
+  return *this;
+}
+
+void FloatKnotSplineBase::moveKnotData(float* buffer_){
+  std::copy( _knotData_, _knotData_ + _knotDataSize_, buffer_ );
+  _knotData_ = buffer_;
+  _ownedKnotData_.reset();
+}
+
+std::string FloatKnotSplineBase::getSummary() const {
+  std::stringstream ss;
+  ss << this->getDialTypeName() << ": spline data = "
+     << GenericToolbox::toString( std::vector<float>(_knotData_, _knotData_ + _knotDataSize_) );
+  ss << std::endl << this->getDialTypeName() << ": defined bounds = { " << _splineBounds_.first << ", " << _splineBounds_.second << " }";
+  ss << std::endl << this->getDialTypeName() << ": allow extrapolation ? " << _allowExtrapolation_;
+  return ss.str();
+}
+
+std::unique_ptr<FloatKnotSplineBase> FloatKnotSplineBase::makeFloatKnotSpline(const DialBase& dialBase_){
+  // exact types only: the cached variants keep their double precision knots
+  auto& type = typeid(dialBase_);
+  if( type == typeid(CompactSpline) ){ return std::make_unique<CompactSplineFloat>( static_cast<const CompactSpline&>(dialBase_) ); }
+  if( type == typeid(MonotonicSpline) ){ return std::make_unique<MonotonicSplineFloat>( static_cast<const MonotonicSpline&>(dialBase_) ); }
+  if( type == typeid(UniformSpline) ){ return std::make_unique<UniformSplineFloat>( static_cast<const UniformSpline&>(dialBase_) ); }
+  if( type == typeid(GeneralSpline) ){ return std::make_unique<GeneralSplineFloat>( static_cast<const GeneralSpline&>(dialBase_) ); }
+  return nullptr;
+}
+
+double FloatKnotSplineBase::getMaxDeviation(const DialBase& dialA_, const DialBase& dialB_,
+                                            const std::pair<double, double>& bounds_, int nSamples_){
+  LogThrowIf( nSamples_ < 2, "At least two samples are needed: " << nSamples_ );
+
+  DialInputBuffer input{};
+  input.getInputBuffer().resize(1);
+
+  double out{0};
+  for( int iSample = 0 ; iSample < nSamples_ ; iSample++ ){
+    input.setInputValue(0, bounds_.first + (bounds_.second - bounds_.first) * iSample / (nSamples_ - 1.));
+    out = std::max( out, std::abs( dialA_.evalResponse(input) - dialB_.evalResponse(input) ) );
+  }
+  return out;
+}
+
+void FloatKnotSplineBase::setKnotData(const std::vector<double>& splineData_, const std::pair<double, double>& splineBounds_){
+  LogThrowIf( splineData_.size() >= size_t(std::numeric_limits<uint32_t>::max()), "Spline data block is too large." );
+
+  _splineBounds_ = splineBounds_;
+  _knotDataSize_ = uint32_t( splineData_.size() );
+  _ownedKnotData_ = std::unique_ptr<float[]>( new float[_knotDataSize_] );
+  std::transform( splineData_.begin(), splineData_.end(), _ownedKnotData_.get(), [](double value_){ return float(value_); } );
+  _knotData_ = _ownedKnotData_.get();
+}
@@ -71,13 +71,3 @@ void GeneralSpline::buildDial(const std::vector<double>& xPoints,
 
 }
 
-double GeneralSpline::evalResponse(const DialInputBuffer& input_) const {
-  double dialInput{input_.getInputBuffer()[0]};
-
-  if( not _allowExtrapolation_ ){
-    if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
-    else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
-  }
-
-  return CalculateGeneralSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()) );
-}
@@ -34,17 +34,3 @@ void LightGraph::buildDial(const TGraph &grf, const std::string& option_) {
   }
 }
 
-double LightGraph::evalResponse(const DialInputBuffer& input_) const {
-  double dialInput{input_.getInputBuffer()[0]};
-
-#ifndef NDEBUG
-  LogThrowIf(not std::isfinite(dialInput), "Invalid input for LightGraph");
-#endif
-
-  if( not _allowExtrapolation_ ){
-    if     (dialInput <= _Data_[1])     { return _Data_[0]; }
-    else if(dialInput >= _Data_.back()) { return _Data_[_Data_.size()-2]; }
-  }
-
-  return CalculateGraph(dialInput,-1E20,1E20,_Data_.data(),_Data_.size());
-}
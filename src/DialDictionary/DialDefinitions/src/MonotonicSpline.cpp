@@ -112,17 +112,3 @@ void MonotonicSpline::buildDial(const std::vector<double>& v1,
 
 }
 
-double MonotonicSpline::evalResponse(const DialInputBuffer& input_) const {
-  double dialInput{input_.getInputBuffer()[0]};
-
-#ifndef NDEBUG
-  LogThrowIf(not std::isfinite(dialInput), "Invalid input for MonotonicSpline");
-#endif
-
-  if( not _allowExtrapolation_ ){
-    if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
-    else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
-  }
-
-  return CalculateMonotonicSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()-2) );
-}
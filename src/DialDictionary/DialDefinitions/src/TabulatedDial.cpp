@@ -0,0 +1,76 @@
+#include "TabulatedDial.h"
+
+#include "GenericToolbox.Utils.h"
+#include "Logger.h"
+
+#include <sstream>
+#include <algorithm>
+#include <vector>
+
+LoggerInit([]{
+  Logger::setUserHeaderStr("[TabulatedDial]");
+});
+
+
+TabulatedDial::TabulatedDial(const TabulatedDial& other_) : DialBase(other_) {
+  *this = other_;
+}
+TabulatedDial& TabulatedDial::operator=(const TabulatedDial& other_){
+  if( this == &other_ ){ return *this; }
+  _nPoints_ = other_._nPoints_;
+  _invStep_ = other_._invStep_;
+  _range_ = other_._range_;
+  _responseTable_ = nullptr;
+  _ownedResponseTable_.reset();
+  if( _nPoints_ != 0 ){
+    _ownedResponseTable_ = std::unique_ptr<float[]>( new float[_nPoints_] );
+    std::copy( other_._responseTable_, other_._responseTable_ + _nPoints_, _ownedResponseTable_.get() );
+    _responseTable_ = _ownedResponseTable_.get();
+  }
+  return *this;
+}
+
+void TabulatedDial::moveResponseTable(float* buffer_){
+  std::copy( _responseTable_, _responseTable_ + _nPoints_, buffer_ );
+  _responseTable_ = buffer_;
+  _ownedResponseTable_.reset();
+}
+
+std::string TabulatedDial::getSummary() const {
+  std::stringstream ss;
+  ss << this->getDialTypeName() << ": " << _nPoints_ << " points over { " << _range_.first << ", " << _range_.second << " }";
+  ss << std::endl << this->getDialTypeName() << ": responses = "
+     << GenericToolbox::toString( std::vector<float>(_responseTable_, _responseTable_ + _nPoints_) );
+  return ss.str();
+}
+
+std::unique_ptr<TabulatedDial> TabulatedDial::makeTabulatedDial(const DialBase& dialBase_, const std::pair<double, double>& range_,
+                                                                int nPoints_, double& maxDeviation_){
+  LogThrowIf( nPoints_ < 2, "At least two points are needed to tabulate a dial: " << nPoints_ );
+  maxDeviation_ = 0;
+  if( not std::isfinite(range_.first) or not std::isfinite(range_.second) or range_.second <= range_.first ){ return nullptr; }
+
+  auto out = std::make_unique<TabulatedDial>();
+  out->_nPoints_ = uint32_t(nPoints_);
+  out->_range_ = range_;
+  out->_invStep_ = (nPoints_ - 1.) / (range_.second - range_.first);
+  out->_ownedResponseTable_ = std::unique_ptr<float[]>( new float[nPoints_] );
+  out->_responseTable_ = out->_ownedResponseTable_.get();
+
+  DialInputBuffer input{};
+  input.getInputBuffer().resize(1);
+
+  double step{(range_.second - range_.first) / (nPoints_ - 1.)};
+  for( int iPoint = 0 ; iPoint < nPoints_ ; iPoint++ ){
+    input.setInputValue(0, range_.first + iPoint * step);
+    out->_ownedResponseTable_[iPoint] = float( dialBase_.evalResponse(input) );
+  }
+
+  // the points themselves only differ by the float rounding
+  for( int iPoint = 0 ; iPoint < nPoints_ - 1 ; iPoint++ ){
+    input.setInputValue(0, range_.first + (iPoint + 0.5) * step);
+    maxDeviation_ = std::max( maxDeviation_, std::abs( out->evalResponse(input) - dialBase_.evalResponse(input) ) );
+  }
+
+  return out;
+}
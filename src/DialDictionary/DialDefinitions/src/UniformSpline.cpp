@@ -82,17 +82,3 @@ void UniformSpline::buildDial(const std::vector<double>& xPoints,
 
 }
 
-double UniformSpline::evalResponse(const DialInputBuffer& input_) const {
-  double dialInput{input_.getInputBuffer()[0]};
-
-#ifndef NDEBUG
-  LogThrowIf(not std::isfinite(dialInput), "Invalid input for UniformSpline");
-#endif
-
-  if( not _allowExtrapolation_ ){
-    if     (dialInput <= _splineBounds_.first) { dialInput = _splineBounds_.first; }
-    else if(dialInput >= _splineBounds_.second){ dialInput = _splineBounds_.second; }
-  }
-
-  return CalculateUniformSpline( dialInput, -1E20, 1E20, _splineData_.data(), int(_splineData_.size()) );
-}
@@ -0,0 +1,98 @@
+#ifndef GUNDAM_DIAL_ARENA_H
+#define GUNDAM_DIAL_ARENA_H
+
+#include "DialBase.h"
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+
+/// DialArena is the storage of the event-by-event dials of a DialCollection.
+/// Instead of one heap allocation (plus a shared_ptr control block) per
+/// dial, the dials are moved into pools holding a single concrete type.
+/// Each pool is made of fixed size chunks, so the addresses never change
+/// once a dial is stored, and the whole arena is freed with a few
+/// deallocations. The float blocks of the single precision splines and of
+/// the tabulated dials are packed in a flat buffer of their pool as well.
+/// The concrete type of a pool is identified by a TypeTag.
+///
+/// Only the dial types built by the factories for event-by-event dials are
+/// handled. The others have to be stored by the caller, and are counted as
+/// foreign dials. The TypeTag is also used by the EventDialCache to resolve
+/// the concrete type of the dials of a collection once.
+class DialArena {
+
+public:
+  enum class TypeTag : uint8_t {
+    Unknown = 0,
+    Shift,
+    Norm,
+    LightGraph,
+    LightGraphCache,
+    CompactSpline,
+    CompactSplineCache,
+    MonotonicSpline,
+    MonotonicSplineCache,
+    UniformSpline,
+    UniformSplineCache,
+    GeneralSpline,
+    GeneralSplineCache,
+    CompactSplineFloat,
+    MonotonicSplineFloat,
+    UniformSplineFloat,
+    GeneralSplineFloat,
+    Tabulated,
+    Mixed, // more than one type: only used to describe a collection
+    nTypeTags
+  };
+
+  static TypeTag getTypeTag(const DialBase& dialBase_);
+  static std::string getTypeTagName(TypeTag typeTag_);
+
+  DialArena() = default;
+
+  // dials are referenced by address
+  DialArena(const DialArena&) = delete;
+  DialArena& operator=(const DialArena&) = delete;
+
+  /// Move the dial into the pool of its type and return its address in the
+  /// arena. Returns nullptr if the type isn't handled: dialBase_ is then
+  /// left untouched and counted as foreign. Thread safe.
+  DialBase* store(std::unique_ptr<DialBase>& dialBase_);
+
+  /// Number of dials of a given type
+  [[nodiscard]] size_t getNbDials(TypeTag typeTag_) const;
+  [[nodiscard]] size_t getNbDials() const;
+  [[nodiscard]] size_t getNbForeignDials() const { return _nForeignDials_; }
+
+  /// The type of all the stored dials: Mixed if more than one or if there
+  /// are foreign dials, Unknown if empty
+  [[nodiscard]] TypeTag getTypeTag() const;
+
+  [[nodiscard]] size_t getMemoryUsage() const;
+  [[nodiscard]] std::string getSummary() const;
+
+private:
+  struct PoolBase{
+    virtual ~PoolBase() = default;
+    virtual DialBase* store(DialBase& dialBase_) = 0;
+    [[nodiscard]] virtual size_t getMemoryUsage() const = 0;
+    size_t nDials{0};
+  };
+  template<typename T> struct Pool;
+
+  PoolBase* fetchPool(TypeTag typeTag_);
+
+  std::array<std::mutex, size_t(TypeTag::nTypeTags)> _mutexList_{};
+  std::array<std::unique_ptr<PoolBase>, size_t(TypeTag::nTypeTags)> _poolList_{};
+  std::atomic<size_t> _nForeignDials_{0};
+
+};
+
+
+#endif //GUNDAM_DIAL_ARENA_H
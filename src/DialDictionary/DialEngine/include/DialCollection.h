@@ -9,6 +9,7 @@
 #include "DialInterface.h"
 #include "DialInputBuffer.h"
 #include "DialResponseSupervisor.h"
+#include "DialArena.h"
 #include "SampleSet.h"
 
 #include "GenericToolbox.Wrappers.h"
@@ -39,11 +40,16 @@ public:
   void setIndex(int index){ _index_ = index; }
   void setSupervisedParameterIndex(int supervisedParameterIndex){ _supervisedParameterIndex_ = supervisedParameterIndex; }
   void setSupervisedParameterSetIndex(int supervisedParameterSetIndex){ _supervisedParameterSetIndex_ = supervisedParameterSetIndex; }
+  void setDeduplicateDials(bool deduplicateDials_);
 
   // const getters
   [[nodiscard]] bool isBinned() const{ return _isBinned_; }
   [[nodiscard]] bool isEnabled() const{ return _isEnabled_; }
   [[nodiscard]] bool isAllowDialExtrapolation() const{ return _allowDialExtrapolation_; }
+  [[nodiscard]] bool isDeduplicateDials() const{ return _deduplicateDials_; }
+  [[nodiscard]] bool isUseDialArena() const{ return _useDialArena_; }
+  [[nodiscard]] bool isUseFloatKnots() const{ return _useFloatKnots_; }
+  [[nodiscard]] bool isUseTabulatedResponse() const{ return _useTabulatedResponse_; }
   [[nodiscard]] int getIndex() const{ return _index_; }
   [[nodiscard]] const std::string &getGlobalDialType() const{return _globalDialType_; }
   [[nodiscard]] const std::string &getGlobalDialSubType() const{ return _globalDialSubType_; }
@@ -51,6 +57,9 @@ public:
   [[nodiscard]] const DataBinSet &getDialBinSet() const{ return _dialBinSet_; }
   [[nodiscard]] const std::vector<std::string> &getDataSetNameList() const{ return _dataSetNameList_; }
   [[nodiscard]] const std::shared_ptr<TFormula> &getApplyConditionFormula() const{ return _applyConditionFormula_; }
+  [[nodiscard]] const std::vector<DialInterface> &getDialInterfaceList() const{ return _dialInterfaceList_; }
+  [[nodiscard]] const std::vector<DialInputBuffer> &getDialInputBufferList() const{ return _dialInputBufferList_; }
+  [[nodiscard]] const std::shared_ptr<DialArena> &getDialArena() const{ return _dialArena_; }
 
   // non-const getters
   DataBinSet &getDialBinSet(){ return _dialBinSet_; }
@@ -60,6 +69,9 @@ public:
 
   // non-trivial getters
   [[nodiscard]] bool isDatasetValid(const std::string& datasetName_) const;
+  /// Concrete type of every dial of the collection if they all come from the
+  /// arena and share the same type, DialArena::TypeTag::Mixed otherwise.
+  [[nodiscard]] DialArena::TypeTag getDialTypeTag() const;
   std::string getTitle() const;
   std::string getSummary(bool shallow_ = true);
   Parameter* getSupervisedParameter() const;
@@ -72,6 +84,13 @@ public:
   void updateInputBuffers();
   size_t getNextDialFreeSlot(){ return _dialFreeSlot_++; }
 
+  /// Store an event-by-event dial in the next free slot and return the slot
+  /// index. If the dial deduplication is enabled and an identical dial has
+  /// already been stored, the dial is dropped and the slot of the stored one
+  /// is returned instead: the events then share the dial and its response.
+  /// With the dial arena, the dial is moved into it. Thread safe.
+  size_t storeEventDial(std::unique_ptr<DialBase> dialBase_);
+
 
 protected:
   void readConfigImpl() override;
@@ -81,6 +100,9 @@ protected:
   bool initializeDialsWithDefinition();
   void readGlobals(const JsonType &config_);
   JsonType fetchDialsDefinition(const JsonType &definitionsList_);
+  /// Input range over which dialBase_ can be evaluated: parameter limits,
+  /// mirror edges and non-extrapolated spline bounds. NaN if unbounded.
+  [[nodiscard]] std::pair<double, double> getTabulationRange(const DialBase& dialBase_) const;
 
 private:
   // parameters
@@ -90,7 +112,14 @@ private:
   bool _disableDialCache_{false};
   bool _enableDialsSummary_{false};
   bool _allowDialExtrapolation_{true};
+  bool _deduplicateDials_{false};
+  bool _useDialArena_{false};
+  bool _useFloatKnots_{false};
+  bool _useTabulatedResponse_{false};
   int _index_{-1};
+  int _tabulatedResponseNbPoints_{128};
+  double _floatKnotsTolerance_{1E-5};
+  double _tabulatedResponseTolerance_{1E-4};
   double _minDialResponse_{std::nan("unset")};
   double _maxDialResponse_{std::nan("unset")};
   double _mirrorLowEdge_{std::nan("unset")};
@@ -113,6 +142,20 @@ private:
   std::shared_ptr<TFormula> _applyConditionFormula_{nullptr};
   GenericToolbox::Atomic<size_t> _dialFreeSlot_{0};
 
+  // content index of the event-by-event dials, only used while loading
+  struct DialDeduplicationIndex;
+  std::shared_ptr<DialDeduplicationIndex> _dialDeduplicationIndex_{nullptr};
+
+  // precision loss of the converted event-by-event dials, only used while
+  // loading
+  struct DialConversionMonitor;
+  std::shared_ptr<DialConversionMonitor> _floatKnotMonitor_{nullptr};
+  std::shared_ptr<DialConversionMonitor> _tabulationMonitor_{nullptr};
+
+  // owns the event-by-event dials when enabled: the entries of
+  // _dialBaseList_ are then non-owning
+  std::shared_ptr<DialArena> _dialArena_{nullptr};
+
   // external refs
   std::vector<ParameterSet>* _parameterSetListPtr_{nullptr};
 
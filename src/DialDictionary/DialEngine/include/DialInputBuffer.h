@@ -8,6 +8,8 @@
 #include "ParameterSet.h"
 
 #include <vector>
+#include <atomic>
+#include <cstdint>
 #include <utility>
 
 
@@ -35,6 +37,9 @@ public:
     };
     MirrorEdges mirrorEdges{};
 
+    /// Modification counter of the parameter when the buffer has been updated
+    uint64_t lastModificationCounter{uint64_t(-1)};
+
     [[nodiscard]] const ParameterSet& getParameterSet(std::vector<ParameterSet>* parSetListPtr_) const {
       return (*parSetListPtr_)[parSetIndex];
     }
@@ -54,7 +59,7 @@ public:
   /// Tell the input buffer about the global vector of fit parameter sets.
   /// This is required, so it must be set before the DialInputBuffer can
   /// be used.
-  void setParSetRef(std::vector<ParameterSet> *parSetRef_){ _parSetListPtr_ = parSetRef_; }
+  void setParSetRef(std::vector<ParameterSet> *parSetRef_){ _parSetListPtr_ = parSetRef_; this->invalidateBuffers(); }
 
   // const getters
   [[nodiscard]] bool isMasked() const{ return _isMasked_; }
@@ -62,9 +67,12 @@ public:
   [[nodiscard]] int getBufferSize() const{ return _inputArraySize_; }
   [[nodiscard]] const std::vector<double>& getInputBuffer() const { return _inputBuffer_; }
   [[nodiscard]] const std::vector<ParameterReference> &getInputParameterIndicesList() const{ return _inputParameterReferenceList_; }
-#if USE_ZLIB
-  [[nodiscard]] const uint32_t& getCurrentHash() const{ return _currentHash_; }
-#endif
+
+  /// Identifies the current content of the buffer. A new value is taken from
+  /// a global counter each time the buffer changes, so two buffers (or two
+  /// states of the same buffer) never share an epoch unless one is an
+  /// untouched copy of the other. Used by CachedDial.
+  [[nodiscard]] uint64_t getEpoch() const{ return _epoch_; }
 
   // mutable getters
 
@@ -76,6 +84,12 @@ public:
   // core
   void invalidateBuffers();
 
+  /// Set an input value by hand (dial scans...). Takes a new epoch.
+  void setInputValue(int iInput_, double value_){ _inputBuffer_[iInput_] = value_; this->renewEpoch(); }
+
+  /// Needs to be called if the buffer has been modified via getInputBuffer()
+  void renewEpoch(){ _epoch_ = generateEpoch(); }
+
   /// Make sure everything is ready for use
   void initialise();
 
@@ -101,9 +115,7 @@ public:
   [[deprecated("use getParameterSet()")]] [[nodiscard]] const ParameterSet& getFitParameterSet(int i=0) const { return getParameterSet(i); }
 
 protected:
-#if USE_ZLIB
-  uint32_t generateHash();
-#endif
+  static uint64_t generateEpoch(){ return ++_lastEpoch_; }
 
 private:
   /// Flag if the member can be still edited.
@@ -120,6 +132,10 @@ private:
   /// How many inputs are handled
   int _inputArraySize_{0};
 
+  /// Content identifier. Starts at 1: 0 is never a valid epoch.
+  uint64_t _epoch_{generateEpoch()};
+  static std::atomic<uint64_t> _lastEpoch_;
+
   /// A pointer to the "global" vector of parameter sets.
   /// This provides the connection to the parameters.
   std::vector<ParameterSet>* _parSetListPtr_{nullptr};
@@ -134,11 +150,6 @@ private:
   /// has one entry)
   std::vector<ParameterReference> _inputParameterReferenceList_{};
 
-#if USE_ZLIB
-  // for cache
-  uint32_t _currentHash_{0};
-#endif
-
 };
 
 
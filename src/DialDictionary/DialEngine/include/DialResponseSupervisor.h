@@ -24,7 +24,12 @@ public:
   [[nodiscard]] double getMinResponse() const{ return _minResponse_; }
   [[nodiscard]] double getMaxResponse() const{ return _maxResponse_; }
 
-  [[nodiscard]] double process(double reponse_) const;
+  [[nodiscard]] double process(double reponse_) const {
+    // apply cap?
+    if     ( not std::isnan(_minResponse_) and reponse_ < _minResponse_ ){ return _minResponse_; }
+    else if( not std::isnan(_maxResponse_) and reponse_ > _maxResponse_ ){ return _maxResponse_; }
+    return reponse_;
+  }
   [[nodiscard]] std::string getSummary() const;
 
 
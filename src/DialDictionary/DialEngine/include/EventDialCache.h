@@ -9,15 +9,21 @@
 #include "DialCollection.h"
 #include "Event.h"
 #include "DialInterface.h"
+#include "DialArena.h"
 
 
 // DEV
 #include "GundamGlobals.h"
+#include "GundamNuma.h"
+#include "CalculateSplineBatch.h"
 
 #include "GenericToolbox.Wrappers.h"
 
 #include <vector>
 #include <utility>
+#include <limits>
+#include <cstdint>
+#include <unordered_set>
 
 
 class EventDialCache{
@@ -117,6 +123,131 @@ public:
     }
   };
 
+  /// Compressed sparse row (CSR) layout of the cache. Instead of having one
+  /// vector of DialResponseCache per event, all (event, dial) pairs are packed
+  /// in flat arrays: the dials of the event eventList[i] are found in the
+  /// range [offsetList[i], offsetList[i+1]) of dialIndexList and
+  /// responseList. This avoids one heap allocation per event and keeps the
+  /// reweight loop on contiguous memory. The per event arrays can be
+  /// relocated such that each thread range is first touched by the thread
+  /// reweighting it (NUMA placement).
+  struct CompressedCache{
+    /// The events to reweight (one per cache entry)
+    GundamNuma::FirstTouchVector<Event*> eventList{};
+    /// Start of the dial range of each event. Has eventList.size()+1 entries.
+    GundamNuma::FirstTouchVector<size_t> offsetList{};
+    /// Packed indices of the dials in dialInterfaceList
+    GundamNuma::FirstTouchVector<uint32_t> dialIndexList{};
+    /// The cached response of each (event, dial) pair. Not used when the
+    /// dial response table is enabled.
+    GundamNuma::FirstTouchVector<double> responseList{};
+    /// Single precision version of responseList: only one of them is used.
+    GundamNuma::FirstTouchVector<float> responseListFloat{};
+    /// Flat view of the DialInterface of every DialCollection.
+    std::vector<DialInterface*> dialInterfaceList{};
+    /// Response of each entry of dialInterfaceList, evaluated once per
+    /// propagation when the dial response table is enabled.
+    std::vector<double> dialResponseTable{};
+    std::vector<float> dialResponseTableFloat{};
+    /// Folded dials: the dials of the event i found in [activeEndList[i],
+    /// offsetList[i+1]) can't move anymore, and the product of their
+    /// responses is kept in foldedReweightList[i]. Both are empty if the
+    /// folding is not used.
+    GundamNuma::FirstTouchVector<size_t> activeEndList{};
+    GundamNuma::FirstTouchVector<double> foldedReweightList{};
+
+    [[nodiscard]] size_t getNbDials(size_t iEntry_) const{ return offsetList[iEntry_+1] - offsetList[iEntry_]; }
+    /// End of the dial range that needs to be evaluated
+    [[nodiscard]] size_t getActiveEnd(size_t iEntry_) const{ return activeEndList.empty() ? offsetList[iEntry_+1] : activeEndList[iEntry_]; }
+    [[nodiscard]] std::string getSummary(size_t iEntry_) const {
+      std::stringstream ss;
+      ss << *eventList[iEntry_] << std::endl;
+      ss << "Dials{";
+      for( size_t iDial = offsetList[iEntry_] ; iDial < offsetList[iEntry_+1] ; iDial++ ){
+        ss << std::endl << "  { " << dialInterfaceList[dialIndexList[iDial]]->getSummary() << " }";
+      }
+      ss << std::endl << "}";
+      return ss.str();
+    }
+  };
+
+  /// Spline dials of the response table sharing the same input, response
+  /// supervisor, spline type and number of knots. They are evaluated in one
+  /// go with the SIMD kernels instead of one virtual call per dial.
+  struct BatchedSplineGroup{
+    const DialInputBuffer* inputBuffer{nullptr};
+    const DialResponseSupervisor* supervisor{nullptr};
+    SplineBatch::Group group{};
+    /// Index of each spline of the group in the dial response table
+    std::vector<uint32_t> tableIndexList{};
+    std::vector<double> responseBuffer{};
+  };
+
+  /// Range of the dial response table filled by one DialCollection. The
+  /// concrete type of the dials is resolved once at build time: if all
+  /// the dials share the same type, the range is evaluated with a loop
+  /// specialised for it (no virtual call, inlined response). Mixed and
+  /// other types (CompiledLibDial...) go through the virtual call.
+  struct DialCollectionRange{
+    uint32_t beginIndex{0};
+    uint32_t endIndex{0};
+    DialArena::TypeTag typeTag{DialArena::TypeTag::Unknown};
+  };
+
+  /// Binned normalisation dials taken out of the per event dial lists. The
+  /// events sharing the same set of such dials (typically all the events of
+  /// a sample bin) refer to the same combination, whose product of
+  /// responses is evaluated once per propagation. If all the events of a
+  /// sample bin share the same combination (dial binning matching or
+  /// coarser than the sample binning), the product is applied to the bin
+  /// content after the fill and the event weights don't include it.
+  /// Otherwise each event only needs one multiplication instead of one per
+  /// normalisation dial.
+  struct FactorizedNormTable{
+    static constexpr uint32_t noCombination{std::numeric_limits<uint32_t>::max()};
+
+    struct BinCombination{
+      uint32_t sampleIndex{0};
+      int binIndex{-1};
+      uint32_t combination{noCombination};
+    };
+
+    /// The dials of the combination i are in [offsetList[i], offsetList[i+1])
+    std::vector<size_t> offsetList{};
+    std::vector<DialInterface*> dialInterfaceList{};
+    /// Flat index of the dials over every DialCollection (same indexing as
+    /// CompressedCache::dialInterfaceList)
+    std::vector<uint32_t> dialIndexList{};
+    /// Epoch of the input buffer of each dial when its combination has been
+    /// evaluated: only the combinations with a modified input are updated
+    std::vector<uint64_t> inputEpochList{};
+    /// Product of the dial responses of each combination
+    std::vector<double> responseList{};
+    /// Combination of each cache entry, or noCombination. The entries of
+    /// the bins listed in binCombinationList have noCombination.
+    std::vector<uint32_t> entryCombinationList{};
+    /// Sample bins whose content is scaled by a combination after the fill
+    std::vector<BinCombination> binCombinationList{};
+
+    [[nodiscard]] size_t getNbCombinations() const{ return responseList.size(); }
+  };
+
+  /// State of an input buffer when its dials have been folded
+  struct FoldedInput{
+    const DialInputBuffer* inputBuffer{nullptr};
+    bool isMasked{false};
+    std::vector<double> inputList{};
+  };
+
+  /// Inverted index of the cache: for each DialInputBuffer, the list of the
+  /// cache entries holding at least one dial that depends on it. This is
+  /// used to only reweight the events affected by the parameters that have
+  /// actually moved (Hesse, scans, one parameter MCMC steps...).
+  struct InputBufferEventIndex{
+    std::vector<const DialInputBuffer*> inputBufferList{};
+    std::vector<std::vector<uint32_t>> entryIndexList{};
+  };
+
   /// A mapping between the event (in the SampleSet, and the dial (in the
   /// DialCollectionVector).  This will be used to build a fast lookup table
   /// between the PhysicsEvent* and the DialInterface* (i.e. a CacheElem_t
@@ -139,9 +270,41 @@ public:
 public:
   EventDialCache() = default;
 
+  // setters
+  void setUseCompressedCache(bool useCompressedCache_){ _useCompressedCache_ = useCompressedCache_; }
+  void setUseDialResponseTable(bool useDialResponseTable_){ _useDialResponseTable_ = useDialResponseTable_; }
+  void setUseIncrementalReweight(bool useIncrementalReweight_){ _useIncrementalReweight_ = useIncrementalReweight_; }
+  void setIncrementalReweightMaxFraction(double incrementalReweightMaxFraction_){ _incrementalReweightMaxFraction_ = incrementalReweightMaxFraction_; }
+  void setUseSinglePrecision(bool useSinglePrecision_){ _useSinglePrecision_ = useSinglePrecision_; }
+  void setUseBatchedSplines(bool useBatchedSplines_){ _useBatchedSplines_ = useBatchedSplines_; }
+  void setUseNormFactorization(bool useNormFactorization_){ _useNormFactorization_ = useNormFactorization_; }
+  void setUseFixedDialFolding(bool useFixedDialFolding_){ _useFixedDialFolding_ = useFixedDialFolding_; }
+
   // returns the current index
   [[nodiscard]] size_t getFillIndex() const { return _fillIndex_; }
 
+  // const getters
+  [[nodiscard]] bool isUseCompressedCache() const { return _useCompressedCache_; }
+  [[nodiscard]] bool isUseDialResponseTable() const { return _useDialResponseTable_; }
+  [[nodiscard]] bool isUseIncrementalReweight() const { return _useIncrementalReweight_; }
+  [[nodiscard]] bool isUseSinglePrecision() const { return _useSinglePrecision_; }
+  [[nodiscard]] bool isUseBatchedSplines() const { return _useBatchedSplines_; }
+  [[nodiscard]] bool isUseNormFactorization() const { return _useNormFactorization_; }
+  [[nodiscard]] bool isUseFixedDialFolding() const { return _useFixedDialFolding_; }
+  [[nodiscard]] const std::vector<FoldedInput>& getFoldedInputList() const { return _foldedInputList_; }
+  /// Incremented each time the dials of the events are reordered by a new folding
+  [[nodiscard]] size_t getFoldEpoch() const { return _foldEpoch_; }
+  [[nodiscard]] const FactorizedNormTable& getFactorizedNormTable() const { return _factorizedNormTable_; }
+  [[nodiscard]] const std::vector<BatchedSplineGroup>& getBatchedSplineGroupList() const { return _batchedSplineGroupList_; }
+  [[nodiscard]] const std::vector<DialCollectionRange>& getDialCollectionRangeList() const { return _dialCollectionRangeList_; }
+  [[nodiscard]] const std::vector<uint32_t>& getUpdatedEntryList() const { return _updatedEntryList_; }
+  [[nodiscard]] const std::vector<double>& getUpdatedEntryPreviousWeightList() const { return _updatedEntryPreviousWeightList_; }
+
+  /// Number of events handled by the cache, whatever the layout used.
+  [[nodiscard]] size_t getNbEntries() const { return _useCompressedCache_ ? _compressedCache_.eventList.size() : _cache_.size(); }
+  [[nodiscard]] std::string getEntrySummary(size_t iEntry_) const;
+  [[nodiscard]] Event* getEntryEventPtr(size_t iEntry_) const { return _useCompressedCache_ ? _compressedCache_.eventList[iEntry_] : _cache_[iEntry_].event; }
+
   /// Provide the event dial cache.  The event dial cache containes a
   /// CacheElem_t object for every dial applied to a physics event.  The
   /// CacheElem_t is a pointer to the PhysicsEvent that will be reweighted and
@@ -152,7 +315,13 @@ public:
   std::vector<CacheEntry> &getCache(){ return _cache_; }
   [[nodiscard]] const std::vector<CacheEntry> &getCache() const{ return _cache_; }
 
+  /// Provide the CSR version of the cache. Only filled if the compressed
+  /// layout has been requested before calling buildReferenceCache().
+  CompressedCache& getCompressedCache(){ return _compressedCache_; }
+  [[nodiscard]] const CompressedCache& getCompressedCache() const { return _compressedCache_; }
+
   GlobalEventReweightCap& getGlobalEventReweightCap(){ return _globalEventReweightCap_; }
+  [[nodiscard]] const GlobalEventReweightCap& getGlobalEventReweightCap() const { return _globalEventReweightCap_; }
 
   /// Allocate entries for events in the indexed cache.  The first parameter
   /// arethe number of events to allocate space for, and the second number is
@@ -165,6 +334,10 @@ public:
   /// of the pointer is not passed to the caller.
   IndexedCacheEntry* fetchNextCacheEntry();
 
+  /// Same as fetchNextCacheEntry, but claims nEntries_ consecutive entries.
+  /// Returns the first one.
+  IndexedCacheEntry* fetchNextCacheEntries(size_t nEntries_);
+
   /// Build the association between pointers to PhysicsEvent objects and the
   /// pointers to DialInterface objects.  This must be done before the event
   /// dial cache can be used, but after the index cache has been filled.
@@ -176,8 +349,92 @@ public:
 
   void reweightEntry( CacheEntry& entry_);
 
+  /// Reweight the event iEntry_ of the compressed cache
+  void reweightEntry( size_t iEntry_ );
+
+  /// Force the next propagation to reweight every event. Needs to be called
+  /// if the event weights have been modified outside the propagation.
+  void requestFullReweight(){ _isFullReweightRequested_ = true; }
+
+  /// Look for the input buffers that have been updated, and fill the list of
+  /// cache entries that need to be reweighted. Returns false if all the
+  /// events should be reweighted instead (too many events involved, or a
+  /// full reweight has been requested).
+  bool fillUpdatedEntryList();
+
+  /// Reweight the iUpdated_-th entry of the updated entry list. The weight
+  /// of the event prior to the reweight is kept in memory, so the sample
+  /// histograms can be updated with the weight variation only.
+  void reweightUpdatedEntry( size_t iUpdated_ );
+
+  /// First step of the two-phase propagation: evaluate every dial interface
+  /// exactly once and store the result in the dial response table. The
+  /// events are then reweighted by only multiplying the table entries.
+  /// Requires the compressed layout.
+  void updateDialResponseTable( int iThread_ = -1 );
+
+  /// Fill the dial response table entries [begin_, end_) with the loop
+  /// specialised for typeTag_: all the dials of the range need to have that
+  /// concrete type, up to the cached variants. Mixed and Unknown go through
+  /// the virtual call. Instantiated for double and float tables.
+  template<typename R> static void evalDialRange(DialArena::TypeTag typeTag_, DialInterface* const* interfaceList_,
+                                                 const char* isBatchedList_, R* table_, int begin_, int end_);
+
+  /// Evaluate the product of responses of each factorized normalisation
+  /// combination. Needs to be called before the events are reweighted.
+  void updateFactorizedNormTable();
+
+  /// Copy the combinations applied per bin into the normalisation factors
+  /// of the MC histogram bins. Needs to be called before the histograms are
+  /// filled. Returns true if one of the factors has changed.
+  bool updateBinNormFactors( SampleSet& sampleSet_ ) const;
+
+  /// Fold the dials whose parameters can't be moved by the fitter (fixed,
+  /// disabled or belonging to a disabled set) into a constant factor per
+  /// event. The folded inputs are checked at each call: if one of them has
+  /// moved anyway, its dials are released for good. Returns true if the
+  /// set of folded dials has changed, in which case foldDials() needs to be
+  /// called by every thread before the next reweight. Compressed layout
+  /// only, and the input buffers need to be up to date.
+  bool updateFoldedDialList();
+  void foldDials( int iThread_ = -1 );
+
+  /// NUMA placement of the compressed cache and of the MC events. The per
+  /// event arrays and the event lists are re-allocated without being touched,
+  /// then each worker thread touches the range it is reweighting with the
+  /// static scheduling. The memory pages end up on the node of the thread
+  /// that is going to read them. The Event pointers are updated.
+  void beginCompressedCacheRelocation( SampleSet& sampleSet_ );
+  void relocateCompressedCache( int iThread_ );
+  void endCompressedCacheRelocation();
+
+protected:
+  void buildCompressedCache(std::vector<std::vector<IndexedCacheEntry>>& sampleIndexCacheList_,
+                            SampleSet& sampleSet_,
+                            std::vector<DialCollection>& dialCollectionList_);
+  void buildInputBufferEventIndex();
+  void buildBatchedSplineGroups();
+  void applyFactorizedNorm(size_t iEntry_, double& reweight_) const{
+    if( _factorizedNormTable_.entryCombinationList.empty() ){ return; }
+    uint32_t iCombination{_factorizedNormTable_.entryCombinationList[iEntry_]};
+    if( iCombination != FactorizedNormTable::noCombination ){ reweight_ *= _factorizedNormTable_.responseList[iCombination]; }
+  }
+  void factorizeNormDials(std::vector<std::vector<IndexedCacheEntry>>& sampleIndexCacheList_,
+                          const SampleSet& sampleSet_,
+                          std::vector<DialCollection>& dialCollectionList_);
+
 
 private:
+  // parameters
+  bool _useCompressedCache_{false};
+  bool _useDialResponseTable_{false};
+  bool _useIncrementalReweight_{false};
+  bool _useSinglePrecision_{false}; // compressed layout only: float storage of the cached responses
+  bool _useBatchedSplines_{false}; // dial response table only
+  bool _useNormFactorization_{false};
+  bool _useFixedDialFolding_{false}; // compressed layout only
+  double _incrementalReweightMaxFraction_{0.5};
+
   // The next available entry in the indexed cache.
   size_t _fillIndex_{0};
 
@@ -192,6 +449,38 @@ private:
   /// associations for efficient use when reweighting the MC events.
   std::vector<CacheEntry> _cache_{};
 
+  /// CSR equivalent of _cache_. Only one of the two is filled.
+  CompressedCache _compressedCache_{};
+  CompressedCache _relocatedCompressedCache_{};
+  std::vector<SampleElement*> _relocatedSampleList_{}; // indexed like Event::Indices::sample
+  std::vector<const Event*> _relocatedEventBeginList_{};
+
+  /// Batched spline evaluation: the flagged entries of the dial response
+  /// table are filled by the groups
+  std::vector<BatchedSplineGroup> _batchedSplineGroupList_{};
+  std::vector<char> _isBatchedList_{};
+
+  /// Devirtualized evaluation of the dial response table
+  std::vector<DialCollectionRange> _dialCollectionRangeList_{};
+
+  /// Binned normalisations applied once per event
+  FactorizedNormTable _factorizedNormTable_{};
+
+  /// Folding of the dials that can't move
+  std::vector<const DialInputBuffer*> _inputBufferList_{}; // every input of the compressed cache
+  std::vector<FoldedInput> _foldedInputList_{};
+  std::vector<char> _isFoldedDialList_{}; // flat dial index
+  std::unordered_set<const DialInputBuffer*> _releasedInputSet_{}; // moved while folded
+  size_t _foldEpoch_{0};
+
+  /// Incremental reweight
+  bool _isFullReweightRequested_{true};
+  uint32_t _currentStamp_{0};
+  std::vector<uint32_t> _entryStampList_{};
+  std::vector<uint32_t> _updatedEntryList_{};
+  std::vector<double> _updatedEntryPreviousWeightList_{};
+  InputBufferEventIndex _inputBufferEventIndex_{};
+
   /// Global cap
   GlobalEventReweightCap _globalEventReweightCap_{};
 };
@@ -0,0 +1,207 @@
+#include "DialArena.h"
+
+#include "Shift.h"
+#include "Norm.h"
+#include "LightGraph.h"
+#include "CompactSpline.h"
+#include "MonotonicSpline.h"
+#include "UniformSpline.h"
+#include "GeneralSpline.h"
+#include "FloatKnotSpline.h"
+#include "TabulatedDial.h"
+
+#include "GenericToolbox.Utils.h"
+#include "Logger.h"
+
+#include <sstream>
+#include <typeinfo>
+#include <algorithm>
+
+LoggerInit([]{
+  Logger::setUserHeaderStr("[DialArena]");
+});
+
+
+namespace {
+  // flat storage of the float blocks of a pool. Filled by chunks, so the
+  // blocks never move once a dial is pointing at them.
+  struct FloatBuffer{
+    static constexpr size_t chunkSize{1 << 16};
+    std::vector<std::unique_ptr<float[]>> chunkList{};
+    size_t nUsed{0};
+    size_t nAllocated{0};
+
+    float* allocate(size_t size_){
+      if( chunkList.empty() or nUsed + size_ > chunkSize ){
+        // a block larger than a chunk gets a chunk of its own
+        size_t newChunkSize{std::max(size_, size_t(chunkSize))};
+        chunkList.emplace_back( new float[newChunkSize] );
+        nAllocated += newChunkSize;
+        nUsed = 0;
+      }
+      float* out{chunkList.back().get() + nUsed};
+      nUsed += size_;
+      return out;
+    }
+  };
+
+  // the dials with bare float blocks get them moved to the pool buffer,
+  // the others keep their own storage
+  template<typename T> void moveFloatData(T&, FloatBuffer&){}
+  template<typename T> void moveFloatData(FloatKnotSpline<T>& dial_, FloatBuffer& buffer_){
+    if( dial_.getKnotDataSize() == 0 ){ return; }
+    dial_.moveKnotData( buffer_.allocate(dial_.getKnotDataSize()) );
+  }
+  void moveFloatData(TabulatedDial& dial_, FloatBuffer& buffer_){
+    if( dial_.getNbPoints() == 0 ){ return; }
+    dial_.moveResponseTable( buffer_.allocate(dial_.getNbPoints()) );
+  }
+}
+
+template<typename T> struct DialArena::Pool : public DialArena::PoolBase {
+  static constexpr size_t chunkSize{4096};
+  std::vector<std::unique_ptr<T[]>> chunkList{};
+  FloatBuffer floatBuffer{};
+
+  DialBase* store(DialBase& dialBase_) override {
+    if( nDials % chunkSize == 0 ){ chunkList.emplace_back( new T[chunkSize] ); }
+    T* slot{&chunkList.back()[nDials % chunkSize]};
+    *slot = std::move( static_cast<T&>(dialBase_) );
+    moveFloatData( *slot, floatBuffer );
+    nDials++;
+    return slot;
+  }
+  [[nodiscard]] size_t getMemoryUsage() const override {
+    // the dynamic members of the double precision dials are not included
+    return chunkList.size() * chunkSize * sizeof(T) + floatBuffer.nAllocated * sizeof(float);
+  }
+};
+
+
+DialArena::TypeTag DialArena::getTypeTag(const DialBase& dialBase_){
+  auto& type = typeid(dialBase_);
+  if( type == typeid(Shift) ){ return TypeTag::Shift; }
+  if( type == typeid(Norm) ){ return TypeTag::Norm; }
+  if( type == typeid(LightGraph) ){ return TypeTag::LightGraph; }
+  if( type == typeid(LightGraphCache) ){ return TypeTag::LightGraphCache; }
+  if( type == typeid(CompactSpline) ){ return TypeTag::CompactSpline; }
+  if( type == typeid(CompactSplineCache) ){ return TypeTag::CompactSplineCache; }
+  if( type == typeid(MonotonicSpline) ){ return TypeTag::MonotonicSpline; }
+  if( type == typeid(MonotonicSplineCache) ){ return TypeTag::MonotonicSplineCache; }
+  if( type == typeid(UniformSpline) ){ return TypeTag::UniformSpline; }
+  if( type == typeid(UniformSplineCache) ){ return TypeTag::UniformSplineCache; }
+  if( type == typeid(GeneralSpline) ){ return TypeTag::GeneralSpline; }
+  if( type == typeid(GeneralSplineCache) ){ return TypeTag::GeneralSplineCache; }
+  if( type == typeid(CompactSplineFloat) ){ return TypeTag::CompactSplineFloat; }
+  if( type == typeid(MonotonicSplineFloat) ){ return TypeTag::MonotonicSplineFloat; }
+  if( type == typeid(UniformSplineFloat) ){ return TypeTag::UniformSplineFloat; }
+  if( type == typeid(GeneralSplineFloat) ){ return TypeTag::GeneralSplineFloat; }
+  if( type == typeid(TabulatedDial) ){ return TypeTag::Tabulated; }
+  return TypeTag::Unknown;
+}
+std::string DialArena::getTypeTagName(TypeTag typeTag_){
+  switch( typeTag_ ){
+    case TypeTag::Shift: return "Shift";
+    case TypeTag::Norm: return "Norm";
+    case TypeTag::LightGraph: return "LightGraph";
+    case TypeTag::LightGraphCache: return "LightGraphCache";
+    case TypeTag::CompactSpline: return "CompactSpline";
+    case TypeTag::CompactSplineCache: return "CompactSplineCache";
+    case TypeTag::MonotonicSpline: return "MonotonicSpline";
+    case TypeTag::MonotonicSplineCache: return "MonotonicSplineCache";
+    case TypeTag::UniformSpline: return "UniformSpline";
+    case TypeTag::UniformSplineCache: return "UniformSplineCache";
+    case TypeTag::GeneralSpline: return "GeneralSpline";
+    case TypeTag::GeneralSplineCache: return "GeneralSplineCache";
+    case TypeTag::CompactSplineFloat: return "CompactSplineFloat";
+    case TypeTag::MonotonicSplineFloat: return "MonotonicSplineFloat";
+    case TypeTag::UniformSplineFloat: return "UniformSplineFloat";
+    case TypeTag::GeneralSplineFloat: return "GeneralSplineFloat";
+    case TypeTag::Tabulated: return "Tabulated";
+    case TypeTag::Mixed: return "Mixed";
+    default: return "Unknown";
+  }
+}
+
+DialBase* DialArena::store(std::unique_ptr<DialBase>& dialBase_){
+  if( dialBase_ == nullptr ){ return nullptr; }
+
+  auto typeTag = getTypeTag(*dialBase_);
+  if( typeTag == TypeTag::Unknown ){ _nForeignDials_++; return nullptr; }
+
+  DialBase* out;
+  {
+    std::lock_guard<std::mutex> lock( _mutexList_[size_t(typeTag)] );
+    auto* pool = this->fetchPool(typeTag);
+    if( pool == nullptr ){ _nForeignDials_++; return nullptr; }
+    out = pool->store(*dialBase_);
+  }
+
+  // only the moved-from shell is left
+  dialBase_.reset();
+  return out;
+}
+
+size_t DialArena::getNbDials(TypeTag typeTag_) const{
+  if( typeTag_ >= TypeTag::Mixed or _poolList_[size_t(typeTag_)] == nullptr ){ return 0; }
+  return _poolList_[size_t(typeTag_)]->nDials;
+}
+size_t DialArena::getNbDials() const{
+  size_t out{0};
+  for( auto& pool : _poolList_ ){ if( pool != nullptr ){ out += pool->nDials; } }
+  return out;
+}
+DialArena::TypeTag DialArena::getTypeTag() const{
+  auto out{TypeTag::Unknown};
+  if( _nForeignDials_ != 0 ){ return TypeTag::Mixed; }
+  for( size_t iTag = 0 ; iTag < _poolList_.size() ; iTag++ ){
+    if( _poolList_[iTag] == nullptr or _poolList_[iTag]->nDials == 0 ){ continue; }
+    if( out != TypeTag::Unknown ){ return TypeTag::Mixed; }
+    out = TypeTag(iTag);
+  }
+  return out;
+}
+size_t DialArena::getMemoryUsage() const{
+  size_t out{0};
+  for( auto& pool : _poolList_ ){ if( pool != nullptr ){ out += pool->getMemoryUsage(); } }
+  return out;
+}
+std::string DialArena::getSummary() const{
+  std::stringstream ss;
+  ss << "DialArena{ " << this->getNbDials() << " dials, "
+     << GenericToolbox::parseSizeUnits(double(this->getMemoryUsage())) << ":";
+  for( size_t iTag = 0 ; iTag < _poolList_.size() ; iTag++ ){
+    if( _poolList_[iTag] == nullptr or _poolList_[iTag]->nDials == 0 ){ continue; }
+    ss << " " << getTypeTagName(TypeTag(iTag)) << "=" << _poolList_[iTag]->nDials;
+  }
+  if( _nForeignDials_ != 0 ){ ss << ", " << _nForeignDials_ << " dials of other types"; }
+  ss << " }";
+  return ss.str();
+}
+
+DialArena::PoolBase* DialArena::fetchPool(TypeTag typeTag_){
+  auto& pool = _poolList_[size_t(typeTag_)];
+  if( pool != nullptr ){ return pool.get(); }
+
+  switch( typeTag_ ){
+    case TypeTag::Shift: pool = std::make_unique<Pool<Shift>>(); break;
+    case TypeTag::Norm: pool = std::make_unique<Pool<Norm>>(); break;
+    case TypeTag::LightGraph: pool = std::make_unique<Pool<LightGraph>>(); break;
+    case TypeTag::LightGraphCache: pool = std::make_unique<Pool<LightGraphCache>>(); break;
+    case TypeTag::CompactSpline: pool = std::make_unique<Pool<CompactSpline>>(); break;
+    case TypeTag::CompactSplineCache: pool = std::make_unique<Pool<CompactSplineCache>>(); break;
+    case TypeTag::MonotonicSpline: pool = std::make_unique<Pool<MonotonicSpline>>(); break;
+    case TypeTag::MonotonicSplineCache: pool = std::make_unique<Pool<MonotonicSplineCache>>(); break;
+    case TypeTag::UniformSpline: pool = std::make_unique<Pool<UniformSpline>>(); break;
+    case TypeTag::UniformSplineCache: pool = std::make_unique<Pool<UniformSplineCache>>(); break;
+    case TypeTag::GeneralSpline: pool = std::make_unique<Pool<GeneralSpline>>(); break;
+    case TypeTag::GeneralSplineCache: pool = std::make_unique<Pool<GeneralSplineCache>>(); break;
+    case TypeTag::CompactSplineFloat: pool = std::make_unique<Pool<CompactSplineFloat>>(); break;
+    case TypeTag::MonotonicSplineFloat: pool = std::make_unique<Pool<MonotonicSplineFloat>>(); break;
+    case TypeTag::UniformSplineFloat: pool = std::make_unique<Pool<UniformSplineFloat>>(); break;
+    case TypeTag::GeneralSplineFloat: pool = std::make_unique<Pool<GeneralSplineFloat>>(); break;
+    case TypeTag::Tabulated: pool = std::make_unique<Pool<TabulatedDial>>(); break;
+    default: LogThrow("No pool for dial type tag: " << int(typeTag_));
+  }
+  return pool.get();
+}
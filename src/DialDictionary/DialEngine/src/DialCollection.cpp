@@ -5,11 +5,25 @@
 #include "GundamGlobals.h"
 #include "DialCollection.h"
 #include "DialBaseFactory.h"
+#include "CompactSpline.h"
+#include "MonotonicSpline.h"
+#include "UniformSpline.h"
+#include "GeneralSpline.h"
+#include "LightGraph.h"
+#include "FloatKnotSpline.h"
+#include "TabulatedDial.h"
 
 #include "GenericToolbox.Json.h"
 #include "Logger.h"
 
 #include <sstream>
+#include <cstring>
+#include <typeinfo>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
 
 
 LoggerInit([]{
@@ -17,6 +31,86 @@ LoggerInit([]{
 });
 
 
+// the index is split in shards with their own lock, so the loading threads
+// rarely wait for each other
+struct DialCollection::DialDeduplicationIndex{
+  static constexpr size_t nShards{64};
+  std::array<std::mutex, nShards> mutexList{};
+  std::array<std::unordered_multimap<uint64_t, size_t>, nShards> slotDictList{};
+  std::atomic<size_t> nStored{0};
+  std::atomic<size_t> nDuplicates{0};
+};
+
+// filled concurrently by the loading threads
+struct DialCollection::DialConversionMonitor{
+  std::atomic<size_t> nConverted{0};
+  std::atomic<size_t> nRejected{0};
+  std::atomic<double> maxDeviation{0};
+
+  void update(double deviation_){
+    nConverted++;
+    double current{maxDeviation.load()};
+    while( deviation_ > current and not maxDeviation.compare_exchange_weak(current, deviation_) ){}
+  }
+};
+
+namespace {
+  // only the dials entirely defined by their data block and their input
+  // range can be compared. Returns false for the other dial types.
+  bool fetchDialBounds(const DialBase& dialBase_, std::pair<double, double>& bounds_){
+    if( auto* dial = dynamic_cast<const CompactSpline*>(&dialBase_) ){ bounds_ = dial->getSplineBounds(); return true; }
+    if( auto* dial = dynamic_cast<const MonotonicSpline*>(&dialBase_) ){ bounds_ = dial->getSplineBounds(); return true; }
+    if( auto* dial = dynamic_cast<const UniformSpline*>(&dialBase_) ){ bounds_ = dial->getSplineBounds(); return true; }
+    if( auto* dial = dynamic_cast<const GeneralSpline*>(&dialBase_) ){ bounds_ = dial->getSplineBounds(); return true; }
+    if( auto* dial = dynamic_cast<const FloatKnotSplineBase*>(&dialBase_) ){ bounds_ = dial->getSplineBounds(); return true; }
+    if( auto* dial = dynamic_cast<const TabulatedDial*>(&dialBase_) ){ bounds_ = dial->getRange(); return true; }
+    if( dynamic_cast<const LightGraph*>(&dialBase_) != nullptr ){ bounds_ = {0, 0}; return true; } // bounds are in the data
+    return false;
+  }
+
+  // data of the dials not using the getDialData() block
+  bool fetchFloatData(const DialBase& dialBase_, const float*& data_, size_t& size_){
+    if( auto* dial = dynamic_cast<const FloatKnotSplineBase*>(&dialBase_) ){ data_ = dial->getKnotData(); size_ = dial->getKnotDataSize(); return true; }
+    if( auto* dial = dynamic_cast<const TabulatedDial*>(&dialBase_) ){ data_ = dial->getResponseTable(); size_ = dial->getNbPoints(); return true; }
+    return false;
+  }
+
+  // FNV-1a like hash of the bit patterns
+  uint64_t hashDial(const DialBase& dialBase_, const std::pair<double, double>& bounds_){
+    uint64_t hash{uint64_t(typeid(dialBase_).hash_code())};
+    auto mixFct = [&](double value_){
+      uint64_t bits;
+      std::memcpy(&bits, &value_, sizeof(bits));
+      hash ^= bits;
+      hash *= 0x100000001b3ULL;
+      hash ^= (hash >> 32);
+    };
+    mixFct(bounds_.first);
+    mixFct(bounds_.second);
+    for( auto& value : dialBase_.getDialData() ){ mixFct(value); }
+    const float* floatData{nullptr};
+    size_t floatDataSize{0};
+    if( fetchFloatData(dialBase_, floatData, floatDataSize) ){
+      for( size_t iData = 0 ; iData < floatDataSize ; iData++ ){ mixFct( floatData[iData] ); }
+    }
+    return hash;
+  }
+
+  bool isSameDial(const DialBase& dialA_, const std::pair<double, double>& boundsA_,
+                  const DialBase& dialB_, const std::pair<double, double>& boundsB_){
+    if( typeid(dialA_) != typeid(dialB_) ){ return false; }
+    if( dialA_.getAllowExtrapolation() != dialB_.getAllowExtrapolation() ){ return false; }
+    if( boundsA_ != boundsB_ ){ return false; }
+    const float* floatDataA{nullptr}; size_t floatDataSizeA{0};
+    const float* floatDataB{nullptr}; size_t floatDataSizeB{0};
+    if( fetchFloatData(dialA_, floatDataA, floatDataSizeA) and fetchFloatData(dialB_, floatDataB, floatDataSizeB) ){
+      return floatDataSizeA == floatDataSizeB and std::equal( floatDataA, floatDataA + floatDataSizeA, floatDataB );
+    }
+    return dialA_.getDialData() == dialB_.getDialData();
+  }
+}
+
+
 void DialCollection::readConfigImpl() {
 
   _dataSetNameList_ = GenericToolbox::Json::fetchValue<std::vector<std::string>>(
@@ -125,6 +219,13 @@ ParameterSet* DialCollection::getSupervisedParameterSet() const{
   return &_parameterSetListPtr_->at(_supervisedParameterSetIndex_);
 }
 
+// setters
+void DialCollection::setDeduplicateDials(bool deduplicateDials_){
+  _deduplicateDials_ = deduplicateDials_;
+  if( not _deduplicateDials_ ){ _dialDeduplicationIndex_ = nullptr; }
+  else if( _dialDeduplicationIndex_ == nullptr ){ _dialDeduplicationIndex_ = std::make_shared<DialDeduplicationIndex>(); }
+}
+
 // core
 void DialCollection::clear(){
   _dialInterfaceList_.clear();
@@ -132,6 +233,10 @@ void DialCollection::clear(){
   _dialInterfaceList_.shrink_to_fit();
   _dialBaseList_.shrink_to_fit();
   _dialFreeSlot_.setValue(0);
+  if( _deduplicateDials_ ){ _dialDeduplicationIndex_ = std::make_shared<DialDeduplicationIndex>(); }
+  if( _useDialArena_ ){ _dialArena_ = std::make_shared<DialArena>(); }
+  if( _useFloatKnots_ ){ _floatKnotMonitor_ = std::make_shared<DialConversionMonitor>(); }
+  if( _useTabulatedResponse_ ){ _tabulationMonitor_ = std::make_shared<DialConversionMonitor>(); }
 }
 void DialCollection::resizeContainers(){
   LogInfo << "Resizing containers of the dial collection \"" << this->getTitle() << "\" from "
@@ -141,6 +246,119 @@ void DialCollection::resizeContainers(){
   _dialInterfaceList_.shrink_to_fit();
   _dialBaseList_.shrink_to_fit();
   this->setupDialInterfaceReferences();
+
+  if( _dialDeduplicationIndex_ != nullptr ){
+    size_t nStored{_dialDeduplicationIndex_->nStored};
+    size_t nDuplicates{_dialDeduplicationIndex_->nDuplicates};
+    LogInfo << "Dial deduplication of \"" << this->getTitle() << "\": " << nDuplicates << "/" << nStored + nDuplicates
+            << " event-by-event dials were duplicates ("
+            << ( nStored + nDuplicates == 0 ? 0. : 100. * double(nDuplicates) / double(nStored + nDuplicates) )
+            << "%), " << nStored << " dials kept." << std::endl;
+    // not needed once loaded
+    _dialDeduplicationIndex_ = std::make_shared<DialDeduplicationIndex>();
+  }
+
+  if( _dialArena_ != nullptr ){
+    LogInfo << "Dial storage of \"" << this->getTitle() << "\": " << _dialArena_->getSummary() << std::endl;
+  }
+
+  if( _floatKnotMonitor_ != nullptr and _floatKnotMonitor_->nConverted != 0 ){
+    double maxDeviation{_floatKnotMonitor_->maxDeviation};
+    LogInfo << "Single precision knots of \"" << this->getTitle() << "\": " << _floatKnotMonitor_->nConverted
+            << " splines converted, max response deviation: " << maxDeviation << std::endl;
+    LogAlertIf( maxDeviation > _floatKnotsTolerance_ ) << "The max response deviation of the single precision knots of \""
+        << this->getTitle() << "\" is above the tolerance: " << maxDeviation << " > " << _floatKnotsTolerance_
+        << ". Consider disabling useFloatKnots." << std::endl;
+  }
+
+  if( _tabulationMonitor_ != nullptr and _tabulationMonitor_->nConverted + _tabulationMonitor_->nRejected != 0 ){
+    LogInfo << "Tabulated responses of \"" << this->getTitle() << "\": " << _tabulationMonitor_->nConverted << " dials tabulated with "
+            << _tabulatedResponseNbPoints_ << " points (max deviation: " << double(_tabulationMonitor_->maxDeviation) << "), "
+            << _tabulationMonitor_->nRejected << " kept as they were (deviation above " << _tabulatedResponseTolerance_
+            << " or no finite input range)." << std::endl;
+  }
+}
+std::pair<double, double> DialCollection::getTabulationRange(const DialBase& dialBase_) const{
+  // what the input buffer can provide
+  std::pair<double, double> out{std::nan("unset"), std::nan("unset")};
+  auto* parPtr{this->getSupervisedParameter()};
+  if( parPtr != nullptr ){ out = {parPtr->getMinValue(), parPtr->getMaxValue()}; }
+  if( _useMirrorDial_ ){ out = {_mirrorLowEdge_, _mirrorHighEdge_}; }
+
+  // the responses are flat beyond the bounds of a non-extrapolated spline
+  std::pair<double, double> bounds{};
+  if( not dialBase_.getAllowExtrapolation() and fetchDialBounds(dialBase_, bounds) and bounds.second > bounds.first ){
+    if( not (out.first > bounds.first) ){ out.first = bounds.first; }
+    if( not (out.second < bounds.second) ){ out.second = bounds.second; }
+  }
+  return out;
+}
+DialArena::TypeTag DialCollection::getDialTypeTag() const{
+  if( _dialArena_ == nullptr ){ return DialArena::TypeTag::Mixed; }
+  return _dialArena_->getTypeTag();
+}
+size_t DialCollection::storeEventDial(std::unique_ptr<DialBase> dialBase_){
+  LogThrowIf( dialBase_ == nullptr, "Can't store a null dial." );
+
+  if( _tabulationMonitor_ != nullptr and _supervisedParameterIndex_ != -1 ){
+    double maxDeviation{0};
+    auto tabulatedDial = TabulatedDial::makeTabulatedDial(
+        *dialBase_, this->getTabulationRange(*dialBase_), _tabulatedResponseNbPoints_, maxDeviation
+    );
+    if( tabulatedDial != nullptr and maxDeviation <= _tabulatedResponseTolerance_ ){
+      _tabulationMonitor_->update( maxDeviation );
+      dialBase_ = std::move( tabulatedDial );
+    }
+    else{ _tabulationMonitor_->nRejected++; }
+  }
+
+  if( _floatKnotMonitor_ != nullptr ){
+    auto floatDial = FloatKnotSplineBase::makeFloatKnotSpline( *dialBase_ );
+    if( floatDial != nullptr ){
+      // compared against the double precision response
+      _floatKnotMonitor_->update( FloatKnotSplineBase::getMaxDeviation( *dialBase_, *floatDial, floatDial->getSplineBounds() ) );
+      dialBase_ = std::move( floatDial );
+    }
+  }
+
+  auto storeFct = [this](std::unique_ptr<DialBase>& dial_){
+    size_t freeSlot{this->getNextDialFreeSlot()};
+    DialBase* arenaDialPtr{_dialArena_ != nullptr ? _dialArena_->store(dial_) : nullptr};
+    if( arenaDialPtr != nullptr ){
+      // non-owning: aliasing an empty shared_ptr, no control block
+      _dialBaseList_[freeSlot] = DialBaseObject( DialBaseObject(), arenaDialPtr );
+    }
+    else{
+      _dialBaseList_[freeSlot] = DialBaseObject( dial_.release() );
+    }
+    return freeSlot;
+  };
+
+  std::pair<double, double> bounds{};
+  if( _dialDeduplicationIndex_ == nullptr or not fetchDialBounds(*dialBase_, bounds) ){
+    return storeFct( dialBase_ );
+  }
+
+  auto& index = *_dialDeduplicationIndex_;
+  uint64_t hash{hashDial(*dialBase_, bounds)};
+  size_t iShard{size_t(hash % DialDeduplicationIndex::nShards)};
+
+  std::lock_guard<std::mutex> lock( index.mutexList[iShard] );
+  auto range = index.slotDictList[iShard].equal_range( hash );
+  for( auto it = range.first ; it != range.second ; ++it ){
+    auto& storedDial = *_dialBaseList_[it->second];
+    std::pair<double, double> storedBounds{};
+    fetchDialBounds(storedDial, storedBounds);
+    if( isSameDial(*dialBase_, bounds, storedDial, storedBounds) ){
+      index.nDuplicates++;
+      return it->second;
+    }
+  }
+
+  size_t freeSlot{storeFct( dialBase_ )};
+  index.slotDictList[iShard].emplace( hash, freeSlot );
+  index.nStored++;
+  return freeSlot;
 }
 void DialCollection::updateInputBuffers(){
   std::for_each(_dialInputBufferList_.begin(), _dialInputBufferList_.end(), [](DialInputBuffer& i_){
@@ -383,6 +601,19 @@ void DialCollection::readGlobals(const JsonType &config_) {
   }
 
   _allowDialExtrapolation_ = GenericToolbox::Json::fetchValue(config_, "allowDialExtrapolation", _allowDialExtrapolation_);
+  _deduplicateDials_ = GenericToolbox::Json::fetchValue(config_, "deduplicateDials", _deduplicateDials_);
+  if( _deduplicateDials_ and _dialDeduplicationIndex_ == nullptr ){ _dialDeduplicationIndex_ = std::make_shared<DialDeduplicationIndex>(); }
+  _useDialArena_ = GenericToolbox::Json::fetchValue(config_, "useDialArena", _useDialArena_);
+  if( _useDialArena_ and _dialArena_ == nullptr ){ _dialArena_ = std::make_shared<DialArena>(); }
+  _useFloatKnots_ = GenericToolbox::Json::fetchValue(config_, "useFloatKnots", _useFloatKnots_);
+  _floatKnotsTolerance_ = GenericToolbox::Json::fetchValue(config_, "floatKnotsTolerance", _floatKnotsTolerance_);
+  if( _useFloatKnots_ and _floatKnotMonitor_ == nullptr ){ _floatKnotMonitor_ = std::make_shared<DialConversionMonitor>(); }
+  _useTabulatedResponse_ = GenericToolbox::Json::fetchValue(config_, "useTabulatedResponse", _useTabulatedResponse_);
+  _tabulatedResponseNbPoints_ = GenericToolbox::Json::fetchValue(config_, "tabulatedResponseNbPoints", _tabulatedResponseNbPoints_);
+  _tabulatedResponseTolerance_ = GenericToolbox::Json::fetchValue(config_, "tabulatedResponseTolerance", _tabulatedResponseTolerance_);
+  LogThrowIf( _useTabulatedResponse_ and _tabulatedResponseNbPoints_ < 2,
+              "tabulatedResponseNbPoints should be at least 2: " << _tabulatedResponseNbPoints_ );
+  if( _useTabulatedResponse_ and _tabulationMonitor_ == nullptr ){ _tabulationMonitor_ = std::make_shared<DialConversionMonitor>(); }
 }
 bool DialCollection::initializeNormDialsWithParBinning() {
   auto binning = GenericToolbox::Json::fetchValue(_config_, "parametersBinningPath", JsonType());
@@ -6,17 +6,17 @@
 
 #include "Logger.h"
 
-#if USE_ZLIB
-#include "zlib.h"
-#endif
-
 LoggerInit([]{
   Logger::setUserHeaderStr("[DialInputBuffer]");
 });
 
+std::atomic<uint64_t> DialInputBuffer::_lastEpoch_{0};
+
 void DialInputBuffer::invalidateBuffers(){
   // invalidate buffer
   for( auto& buf : _inputBuffer_ ){ buf = std::nan("unset"); }
+  for( auto& parRef : _inputParameterReferenceList_ ){ parRef.lastModificationCounter = uint64_t(-1); }
+  this->renewEpoch();
 }
 
 void DialInputBuffer::initialise(){
@@ -63,8 +63,13 @@ void DialInputBuffer::update(){
   double tempBuffer;
   _isDialUpdateRequested_ = false; // if ANY is different, request the update
   for( auto& inputRef : _inputParameterReferenceList_ ){
+    // nothing to do if the parameter hasn't been modified since the last update
+    auto& par = inputRef.getParameter(_parSetListPtr_);
+    if( par.getModificationCounter() == inputRef.lastModificationCounter ){ continue; }
+    inputRef.lastModificationCounter = par.getModificationCounter();
+
     // grab the value of the parameter
-    tempBuffer = inputRef.getParameter(_parSetListPtr_).getParameterValue();
+    tempBuffer = par.getParameterValue();
 
     // find the actual parameter value if mirroring is applied
     if( not std::isnan( inputRef.mirrorEdges.minValue ) ){
@@ -90,9 +95,7 @@ void DialInputBuffer::update(){
     }
   }
 
-#if USE_ZLIB
-  _currentHash_ = generateHash();
-#endif
+  if( _isDialUpdateRequested_ ){ this->renewEpoch(); }
 }
 void DialInputBuffer::addParameterReference( const ParameterReference& parReference_){
   LogThrowIf(_isInitialized_, "Can't add parameter index while initialized.");
@@ -122,15 +125,3 @@ std::string DialInputBuffer::getSummary() const{
 
   return ss.str();
 }
-
-#if USE_ZLIB
-uint32_t DialInputBuffer::generateHash(){
-  uint32_t out = crc32(0L, Z_NULL, 0);
-  double* inputPtr = _inputBuffer_.data();
-  while( inputPtr < _inputBuffer_.data() + _inputBuffer_.size() ){
-    out = crc32( out, (const Bytef*) inputPtr, sizeof(double) );
-    inputPtr++;
-  }
-  return out;
-}
-#endif
@@ -3,18 +3,102 @@
 //
 
 #include "EventDialCache.h"
+#include "CompactSpline.h"
+#include "MonotonicSpline.h"
+#include "UniformSpline.h"
+#include "GeneralSpline.h"
+#include "LightGraph.h"
+#include "Shift.h"
+#include "Norm.h"
+#include "FloatKnotSpline.h"
+#include "TabulatedDial.h"
 
 #include "Logger.h"
 
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
 LoggerInit([]{
   Logger::setUserHeaderStr("[EventDialCache]");
 });
 
+
+namespace {
+
+  // response of a dial whose concrete type is known: the qualified call
+  // bypasses the vtable and lets the compiler inline the response
+  template<typename T> struct TypedResponse{
+    static double eval(const DialBase& dial_, const DialInputBuffer& input_){
+      return static_cast<const T&>(dial_).T::evalResponse(input_);
+    }
+  };
+  template<> struct TypedResponse<DialBase>{
+    static double eval(const DialBase& dial_, const DialInputBuffer& input_){ return dial_.evalResponse(input_); }
+  };
+
+  // same as DialInterface::evalResponse() for the table entries [begin_, end_)
+  template<typename T, typename R>
+  void evalTypedDialRange(DialInterface* const* interfaceList_, const char* isBatchedList_, R* table_, int begin_, int end_){
+    for( int iDial = begin_ ; iDial < end_ ; iDial++ ){
+      if( isBatchedList_ != nullptr and isBatchedList_[iDial] ){ continue; }
+      auto* dialInterface = interfaceList_[iDial];
+      auto* inputBuffer = dialInterface->getInputBufferRef();
+      if( not inputBuffer->isDialUpdateRequested() ){ continue; }
+      if( inputBuffer->isMasked() ){ table_[iDial] = R(1); continue; }
+      table_[iDial] = R( dialInterface->getResponseSupervisorRef()->process(
+          TypedResponse<T>::eval( *dialInterface->getDialBaseRef(), *inputBuffer )
+      ) );
+    }
+  }
+
+}
+
+// the cached variants are evaluated with their base type: each entry of the
+// table is only computed once per propagation anyway
+template<typename R>
+void EventDialCache::evalDialRange(DialArena::TypeTag typeTag_, DialInterface* const* interfaceList_, const char* isBatchedList_,
+                                   R* table_, int begin_, int end_){
+  using TypeTag = DialArena::TypeTag;
+  switch( typeTag_ ){
+    case TypeTag::Shift:
+      evalTypedDialRange<Shift>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::Norm:
+      evalTypedDialRange<Norm>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::LightGraph: case TypeTag::LightGraphCache:
+      evalTypedDialRange<LightGraph>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::CompactSpline: case TypeTag::CompactSplineCache:
+      evalTypedDialRange<CompactSpline>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::MonotonicSpline: case TypeTag::MonotonicSplineCache:
+      evalTypedDialRange<MonotonicSpline>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::UniformSpline: case TypeTag::UniformSplineCache:
+      evalTypedDialRange<UniformSpline>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::GeneralSpline: case TypeTag::GeneralSplineCache:
+      evalTypedDialRange<GeneralSpline>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::CompactSplineFloat:
+      evalTypedDialRange<CompactSplineFloat>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::MonotonicSplineFloat:
+      evalTypedDialRange<MonotonicSplineFloat>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::UniformSplineFloat:
+      evalTypedDialRange<UniformSplineFloat>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::GeneralSplineFloat:
+      evalTypedDialRange<GeneralSplineFloat>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    case TypeTag::Tabulated:
+      evalTypedDialRange<TabulatedDial>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+    default:
+      evalTypedDialRange<DialBase>(interfaceList_, isBatchedList_, table_, begin_, end_); break;
+  }
+}
+template void EventDialCache::evalDialRange<double>(DialArena::TypeTag, DialInterface* const*, const char*, double*, int, int);
+template void EventDialCache::evalDialRange<float>(DialArena::TypeTag, DialInterface* const*, const char*, float*, int, int);
+
 void EventDialCache::buildReferenceCache( SampleSet& sampleSet_, std::vector<DialCollection>& dialCollectionList_){
   LogInfo << "Building event dial cache..." << std::endl;
 
   LogInfo << "Indexed cache size: " << _indexedCache_.size() << std::endl;
-  LogInfo << "Sorting events in sync with indexed cache..." << std::endl;
 
   size_t nCacheSlots{0};
   std::vector<std::vector<IndexedCacheEntry>> sampleIndexCacheList{sampleSet_.getSampleList().size()};
@@ -22,52 +106,61 @@ void EventDialCache::buildReferenceCache( SampleSet& sampleSet_, std::vector<Dia
   {
     LogScopeIndent;
     LogInfo << "Breaking down indexed cache per sample..." << std::endl;
+    // each entry goes in the slot of its event
+    for( auto& sample : sampleSet_.getSampleList() ){
+      sampleIndexCacheList[sample.getIndex()].resize( sample.getMcContainer().getEventList().size() );
+    }
+    std::vector<size_t> sampleNbEntries(sampleIndexCacheList.size(), 0);
+    std::vector<std::vector<bool>> isFilledList(sampleIndexCacheList.size());
+    for( size_t iSample = 0 ; iSample < sampleIndexCacheList.size() ; iSample++ ){
+      isFilledList[iSample].resize( sampleIndexCacheList[iSample].size(), false );
+    }
     for( auto& entry : _indexedCache_ ){
       if( entry.event.sampleIndex == size_t(-1) ){ continue; }
       if( entry.event.eventIndex == size_t(-1) ){ continue; }
 
-      sampleIndexCacheList[entry.event.sampleIndex].emplace_back( entry );
-      sampleIndexCacheList[entry.event.sampleIndex].back().dials.clear();
+      LogThrowIf( entry.event.eventIndex >= sampleIndexCacheList[entry.event.sampleIndex].size(),
+                  "Cache entry pointing outside of the event list: " << entry.event );
+      LogThrowIf( isFilledList[entry.event.sampleIndex][entry.event.eventIndex],
+                  "Two cache entries pointing to the same event: " << entry.event );
+      isFilledList[entry.event.sampleIndex][entry.event.eventIndex] = true;
+      auto& cacheEntry = sampleIndexCacheList[entry.event.sampleIndex][entry.event.eventIndex];
+      cacheEntry.event = entry.event;
       for( auto& dial : entry.dials ){
         if( dial.collectionIndex == size_t(-1) ){ continue; }
         if( dial.interfaceIndex == size_t(-1)  ){ continue; }
-        sampleIndexCacheList[entry.event.sampleIndex].back().dials.emplace_back(dial);
+        cacheEntry.dials.emplace_back(dial);
       }
+      sampleNbEntries[entry.event.sampleIndex]++;
     }
 
     LogInfo << "Cleaning up the index cache..." << std::endl;
     _indexedCache_.clear();
 
-    LogInfo << "Performing per sample sorting..." << std::endl;
     int iSample{-1};
     for( auto& sample : sampleSet_.getSampleList() ){
       iSample++;
 
-      auto p = GenericToolbox::getSortPermutation(
-          sample.getMcContainer().getEventList(), []( const Event& a, const Event& b) {
-            if( a.getIndices().dataset < a.getIndices().dataset ){ return true; }
-            if( a.getIndices().entry < b.getIndices().entry ){ return true; }
-            return false;
-          });
-
       LogThrowIf(
-          sampleIndexCacheList[iSample].size() != sample.getMcContainer().getEventList().size(),
+          sampleNbEntries[iSample] != sample.getMcContainer().getEventList().size(),
           std::endl << "MISMATCH cache and event list for sample: #" << sample.getIndex() << " " << sample.getName()
-              << std::endl << GET_VAR_NAME_VALUE(sampleIndexCacheList[iSample].size())
+              << std::endl << GET_VAR_NAME_VALUE(sampleNbEntries[iSample])
               << " <-> " << GET_VAR_NAME_VALUE(sample.getMcContainer().getEventList().size())
       );
+      // one entry per slot and no collision: every event has its entry
       nCacheSlots += sampleIndexCacheList[iSample].size();
+    }
 
-      GenericToolbox::applyPermutation( sample.getMcContainer().getEventList(), p );
-      GenericToolbox::applyPermutation( sampleIndexCacheList[iSample],     p );
+  }
 
-      // now update the event indices
-      for( size_t iEvent = 0 ; iEvent < sample.getMcContainer().getEventList().size() ; iEvent++ ){
-        sampleIndexCacheList[iSample][iEvent].event.eventIndex = iEvent;
-      }
+  // binned normalisations of a previous table
+  for( auto& sample : sampleSet_.getSampleList() ){
+    for( int iBin = 0 ; iBin < sample.getMcContainer().getHistogram().nBins ; iBin++ ){
+      sample.getMcContainer().setBinNormFactor(iBin, 1);
     }
-
   }
+  _factorizedNormTable_ = FactorizedNormTable();
+  if( _useNormFactorization_ ){ this->factorizeNormDials( sampleIndexCacheList, sampleSet_, dialCollectionList_ ); }
 
   auto countValidDials = [](std::vector<DialIndexCacheEntry>& dialIndices_){
     return std::count_if(dialIndices_.begin(), dialIndices_.end(),
@@ -78,6 +171,12 @@ void EventDialCache::buildReferenceCache( SampleSet& sampleSet_, std::vector<Dia
       });
   };
 
+  if( _useCompressedCache_ ){
+    this->buildCompressedCache( sampleIndexCacheList, sampleSet_, dialCollectionList_ );
+    if( _useIncrementalReweight_ ){ this->buildInputBufferEventIndex(); }
+    return;
+  }
+
   LogInfo << "Filling up the " << nCacheSlots << " cache dial with references..." << std::endl;
   _cache_.reserve( nCacheSlots );
 
@@ -107,6 +206,461 @@ void EventDialCache::buildReferenceCache( SampleSet& sampleSet_, std::vector<Dia
       }
     }
   }
+
+  if( _useIncrementalReweight_ ){ this->buildInputBufferEventIndex(); }
+}
+void EventDialCache::buildInputBufferEventIndex(){
+  LogInfo << "Building the input buffer to event inverted index..." << std::endl;
+
+  _inputBufferEventIndex_ = InputBufferEventIndex();
+  _updatedEntryList_.clear();
+  _isFullReweightRequested_ = true;
+
+  size_t nEntries{this->getNbEntries()};
+  LogThrowIf(nEntries >= size_t(std::numeric_limits<uint32_t>::max()),
+             "Too many events for the incremental reweight: " << nEntries);
+
+  std::unordered_map<const DialInputBuffer*, size_t> inputBufferIndexDict{};
+  auto addEntryFct = [&](const DialInputBuffer* inputBuffer_, size_t iEntry_){
+    auto it = inputBufferIndexDict.find( inputBuffer_ );
+    if( it == inputBufferIndexDict.end() ){
+      it = inputBufferIndexDict.emplace( inputBuffer_, _inputBufferEventIndex_.inputBufferList.size() ).first;
+      _inputBufferEventIndex_.inputBufferList.emplace_back( inputBuffer_ );
+      _inputBufferEventIndex_.entryIndexList.emplace_back();
+    }
+    auto& entryIndexList = _inputBufferEventIndex_.entryIndexList[it->second];
+    // the same event can have more than one dial depending on the same input
+    if( not entryIndexList.empty() and entryIndexList.back() == uint32_t(iEntry_) ){ return; }
+    entryIndexList.emplace_back( uint32_t(iEntry_) );
+  };
+
+  auto& normTable = _factorizedNormTable_;
+  for( size_t iEntry = 0 ; iEntry < nEntries ; iEntry++ ){
+    if( not normTable.entryCombinationList.empty() and normTable.entryCombinationList[iEntry] != FactorizedNormTable::noCombination ){
+      uint32_t iCombination{normTable.entryCombinationList[iEntry]};
+      for( size_t iDial = normTable.offsetList[iCombination] ; iDial < normTable.offsetList[iCombination+1] ; iDial++ ){
+        addEntryFct( normTable.dialInterfaceList[iDial]->getInputBufferRef(), iEntry );
+      }
+    }
+    if( _useCompressedCache_ ){
+      for( size_t iDial = _compressedCache_.offsetList[iEntry] ; iDial < _compressedCache_.offsetList[iEntry+1] ; iDial++ ){
+        addEntryFct(
+            _compressedCache_.dialInterfaceList[_compressedCache_.dialIndexList[iDial]]->getInputBufferRef(),
+            iEntry
+        );
+      }
+    }
+    else{
+      for( auto& dialResponseCache : _cache_[iEntry].dialResponseCacheList ){
+        addEntryFct( dialResponseCache.dialInterface.getInputBufferRef(), iEntry );
+      }
+    }
+  }
+
+  size_t nRefs{0};
+  for( auto& entryIndexList : _inputBufferEventIndex_.entryIndexList ){
+    entryIndexList.shrink_to_fit();
+    nRefs += entryIndexList.size();
+  }
+  LogInfo << _inputBufferEventIndex_.inputBufferList.size() << " input buffers are referencing "
+          << nRefs << " events (" << GenericToolbox::parseSizeUnits(double(nRefs) * sizeof(uint32_t)) << ")" << std::endl;
+
+  _currentStamp_ = 0;
+  _entryStampList_.clear();
+  _entryStampList_.resize( nEntries, 0 );
+  _updatedEntryList_.reserve( nEntries );
+  _updatedEntryPreviousWeightList_.reserve( nEntries );
+}
+void EventDialCache::buildCompressedCache(
+    std::vector<std::vector<IndexedCacheEntry>>& sampleIndexCacheList_,
+    SampleSet& sampleSet_, std::vector<DialCollection>& dialCollectionList_){
+  LogInfo << "Building compressed (CSR) event dial cache..." << std::endl;
+
+  _compressedCache_ = CompressedCache();
+
+  // flat indexing of every dial interface: offset of each collection
+  std::vector<size_t> collectionOffsetList{};
+  collectionOffsetList.reserve( dialCollectionList_.size() );
+  size_t nInterfaces{0};
+  for( auto& dialCollection : dialCollectionList_ ){
+    collectionOffsetList.emplace_back( nInterfaces );
+    nInterfaces += dialCollection.getDialInterfaceList().size();
+  }
+  LogThrowIf(nInterfaces >= size_t(std::numeric_limits<uint32_t>::max()),
+             "Too many dial interfaces for the compressed cache: " << nInterfaces);
+
+  _compressedCache_.dialInterfaceList.reserve( nInterfaces );
+  for( auto& dialCollection : dialCollectionList_ ){
+    for( auto& dialInterface : dialCollection.getDialInterfaceList() ){
+      _compressedCache_.dialInterfaceList.emplace_back( &dialInterface );
+    }
+  }
+
+  // concrete dial type of each collection for the table evaluation
+  _dialCollectionRangeList_.clear();
+  if( _useDialResponseTable_ ){
+    size_t nDevirtualized{0};
+    for( size_t iCollection = 0 ; iCollection < dialCollectionList_.size() ; iCollection++ ){
+      DialCollectionRange range;
+      range.beginIndex = uint32_t( collectionOffsetList[iCollection] );
+      range.endIndex = uint32_t( range.beginIndex + dialCollectionList_[iCollection].getDialInterfaceList().size() );
+      if( range.beginIndex == range.endIndex ){ continue; }
+
+      range.typeTag = DialArena::getTypeTag( *_compressedCache_.dialInterfaceList[range.beginIndex]->getDialBaseRef() );
+      for( uint32_t iDial = range.beginIndex + 1 ; iDial < range.endIndex ; iDial++ ){
+        if( DialArena::getTypeTag( *_compressedCache_.dialInterfaceList[iDial]->getDialBaseRef() ) != range.typeTag ){
+          range.typeTag = DialArena::TypeTag::Mixed;
+          break;
+        }
+      }
+
+      if( range.typeTag != DialArena::TypeTag::Mixed and range.typeTag != DialArena::TypeTag::Unknown ){
+        nDevirtualized += range.endIndex - range.beginIndex;
+      }
+      _dialCollectionRangeList_.emplace_back( range );
+    }
+    LogInfo << nDevirtualized << "/" << nInterfaces << " dials have a type resolved per collection." << std::endl;
+  }
+
+  // count the slots first to allocate everything in one go
+  size_t nEvents{0};
+  size_t nDials{0};
+  for( auto& sampleIndexCache : sampleIndexCacheList_ ){
+    nEvents += sampleIndexCache.size();
+    for( auto& indexCache : sampleIndexCache ){ nDials += indexCache.dials.size(); }
+  }
+
+  size_t responseSize{_useSinglePrecision_ ? sizeof(float) : sizeof(double)};
+  LogInfo << "Filling up " << nEvents << " events with " << nDials << " dial references ("
+          << GenericToolbox::parseSizeUnits(
+              double(nEvents) * (sizeof(Event*) + sizeof(size_t))
+              + double(nDials) * (sizeof(uint32_t) + (_useDialResponseTable_ ? 0 : responseSize))
+              + double(_useDialResponseTable_ ? nInterfaces : 0) * responseSize
+          ) << ")" << std::endl;
+
+  _compressedCache_.eventList.reserve( nEvents );
+  _compressedCache_.offsetList.reserve( nEvents + 1 );
+  _compressedCache_.dialIndexList.reserve( nDials );
+  if( _useDialResponseTable_ ){
+    // the responses are shared by all events
+    if( _useSinglePrecision_ ){ _compressedCache_.dialResponseTableFloat.resize( nInterfaces, std::nanf("unset") ); }
+    else{ _compressedCache_.dialResponseTable.resize( nInterfaces, std::nan("unset") ); }
+  }
+  else{
+    if( _useSinglePrecision_ ){ _compressedCache_.responseListFloat.resize( nDials, std::nanf("unset") ); }
+    else{ _compressedCache_.responseList.resize( nDials, std::nan("unset") ); }
+  }
+
+  _compressedCache_.offsetList.emplace_back( 0 );
+  for( auto& sampleIndexCache : sampleIndexCacheList_ ){
+    for( auto& indexCache : sampleIndexCache ){
+
+      _compressedCache_.eventList.emplace_back(
+          &sampleSet_.getSampleList().at(
+              indexCache.event.sampleIndex
+          ).getMcContainer().getEventList().at(
+              indexCache.event.eventIndex
+          )
+      );
+
+      // invalid dials have already been stripped while breaking down per sample
+      for( auto& dialIndex : indexCache.dials ){
+        _compressedCache_.dialIndexList.emplace_back(
+            uint32_t( collectionOffsetList[dialIndex.collectionIndex] + dialIndex.interfaceIndex )
+        );
+      }
+
+      _compressedCache_.offsetList.emplace_back( _compressedCache_.dialIndexList.size() );
+    }
+  }
+
+  if( _useDialResponseTable_ and _useBatchedSplines_ ){ this->buildBatchedSplineGroups(); }
+
+  // nothing is folded until the first propagation
+  _inputBufferList_.clear();
+  _foldedInputList_.clear();
+  _isFoldedDialList_.clear();
+  _releasedInputSet_.clear();
+  if( _useFixedDialFolding_ ){
+    std::unordered_set<const DialInputBuffer*> inputBufferSet{};
+    for( auto* dialInterface : _compressedCache_.dialInterfaceList ){
+      if( inputBufferSet.insert( dialInterface->getInputBufferRef() ).second ){
+        _inputBufferList_.emplace_back( dialInterface->getInputBufferRef() );
+      }
+    }
+  }
+}
+void EventDialCache::factorizeNormDials(
+    std::vector<std::vector<IndexedCacheEntry>>& sampleIndexCacheList_,
+    const SampleSet& sampleSet_,
+    std::vector<DialCollection>& dialCollectionList_){
+  LogInfo << "Factorizing the binned normalisation dials..." << std::endl;
+
+  // the response of a binned Norm dial doesn't depend on the event: only
+  // the set of such dials an event holds matters
+  std::vector<bool> isFactorizedList(dialCollectionList_.size(), false);
+  std::vector<size_t> collectionOffsetList{};
+  std::vector<DialInterface*> flatInterfaceList{};
+  size_t nFactorizedCollections{0};
+  for( size_t iCollection = 0 ; iCollection < dialCollectionList_.size() ; iCollection++ ){
+    auto& dialInterfaceList = dialCollectionList_[iCollection].getDialInterfaceList();
+    collectionOffsetList.emplace_back( flatInterfaceList.size() );
+    for( auto& dialInterface : dialInterfaceList ){ flatInterfaceList.emplace_back( &dialInterface ); }
+
+    if( not dialCollectionList_[iCollection].isBinned() or dialInterfaceList.empty() ){ continue; }
+    isFactorizedList[iCollection] = std::all_of(
+        dialInterfaceList.begin(), dialInterfaceList.end(), [](const DialInterface& dialInterface_){
+          return DialArena::getTypeTag( *dialInterface_.getDialBaseRef() ) == DialArena::TypeTag::Norm;
+        });
+    if( isFactorizedList[iCollection] ){ nFactorizedCollections++; }
+  }
+  LogThrowIf(flatInterfaceList.size() >= size_t(std::numeric_limits<uint32_t>::max()),
+             "Too many dial interfaces for the norm factorization: " << flatInterfaceList.size());
+  LogReturnIf(nFactorizedCollections == 0, "No binned normalisation dial collection to factorize.");
+
+  auto& table = _factorizedNormTable_;
+  table.offsetList.emplace_back( 0 );
+
+  std::map<std::vector<uint32_t>, uint32_t> combinationIndexDict{};
+  std::vector<uint32_t> combination{};
+  size_t nFactorizedPairs{0};
+  for( auto& sampleIndexCache : sampleIndexCacheList_ ){
+    for( auto& indexCache : sampleIndexCache ){
+
+      // the other dials are kept in their original order
+      combination.clear();
+      size_t nKept{0};
+      for( auto& dialIndex : indexCache.dials ){
+        if( isFactorizedList[dialIndex.collectionIndex] ){
+          combination.emplace_back( uint32_t( collectionOffsetList[dialIndex.collectionIndex] + dialIndex.interfaceIndex ) );
+        }
+        else{ indexCache.dials[nKept++] = dialIndex; }
+      }
+      indexCache.dials.resize( nKept );
+
+      if( combination.empty() ){
+        table.entryCombinationList.emplace_back( uint32_t(FactorizedNormTable::noCombination) );
+        continue;
+      }
+      nFactorizedPairs += combination.size();
+
+      // the product doesn't depend on the order
+      std::sort( combination.begin(), combination.end() );
+      auto it = combinationIndexDict.find( combination );
+      if( it == combinationIndexDict.end() ){
+        it = combinationIndexDict.emplace( combination, uint32_t(table.responseList.size()) ).first;
+        for( auto iDial : combination ){
+          table.dialIndexList.emplace_back( iDial );
+          table.dialInterfaceList.emplace_back( flatInterfaceList[iDial] );
+          table.inputEpochList.emplace_back( 0 ); // never a valid epoch
+        }
+        table.offsetList.emplace_back( table.dialIndexList.size() );
+        table.responseList.emplace_back( std::nan("unset") );
+      }
+      table.entryCombinationList.emplace_back( it->second );
+    }
+  }
+
+  LogInfo << nFactorizedCollections << " dial collections factorized: " << nFactorizedPairs
+          << " event-dial pairs replaced by " << table.getNbCombinations() << " combinations." << std::endl;
+
+  // the cap applies to the full reweight of each event
+  LogReturnIf(_globalEventReweightCap_.isEnabled, "Event reweight cap enabled: the combinations are applied per event.");
+
+  // the bins whose events are all sharing the same combination get it
+  // applied on their content instead
+  size_t nBinCombinations{0};
+  size_t nBinEntries{0};
+  size_t entryOffset{0};
+  const uint32_t unsetCombination{FactorizedNormTable::noCombination - 1};
+  for( size_t iSample = 0 ; iSample < sampleIndexCacheList_.size() ; iSample++ ){
+    auto& eventList = sampleSet_.getSampleList()[iSample].getMcContainer().getEventList();
+    auto nBins = size_t( sampleSet_.getSampleList()[iSample].getMcContainer().getHistogram().nBins );
+
+    std::vector<uint32_t> binCombinationList(nBins, unsetCombination);
+    std::vector<char> isUniformList(nBins, true);
+    for( size_t iEvent = 0 ; iEvent < eventList.size() ; iEvent++ ){
+      int iBin{eventList[iEvent].getIndices().bin};
+      if( iBin < 0 ){ continue; }
+      LogThrowIf( size_t(iBin) >= nBins, "Event bin index out of the histogram: " << iBin );
+      uint32_t iCombination{table.entryCombinationList[entryOffset + iEvent]};
+      if( binCombinationList[iBin] == unsetCombination ){ binCombinationList[iBin] = iCombination; }
+      else if( binCombinationList[iBin] != iCombination ){ isUniformList[iBin] = false; }
+    }
+
+    for( size_t iBin = 0 ; iBin < nBins ; iBin++ ){
+      if( not isUniformList[iBin] ){ continue; }
+      if( binCombinationList[iBin] == unsetCombination or binCombinationList[iBin] == FactorizedNormTable::noCombination ){ continue; }
+      table.binCombinationList.emplace_back();
+      table.binCombinationList.back().sampleIndex = uint32_t(iSample);
+      table.binCombinationList.back().binIndex = int(iBin);
+      table.binCombinationList.back().combination = binCombinationList[iBin];
+      nBinCombinations++;
+    }
+
+    for( size_t iEvent = 0 ; iEvent < eventList.size() ; iEvent++ ){
+      int iBin{eventList[iEvent].getIndices().bin};
+      if( iBin < 0 or not isUniformList[iBin] ){ continue; }
+      if( table.entryCombinationList[entryOffset + iEvent] == FactorizedNormTable::noCombination ){ continue; }
+      table.entryCombinationList[entryOffset + iEvent] = FactorizedNormTable::noCombination;
+      nBinEntries++;
+    }
+
+    entryOffset += sampleIndexCacheList_[iSample].size();
+  }
+  LogInfo << nBinCombinations << " sample bins scaled after the fill: " << nBinEntries
+          << " events don't need the per event product anymore." << std::endl;
+}
+void EventDialCache::buildBatchedSplineGroups(){
+  LogInfo << "Grouping the spline dials for the batched evaluation..." << std::endl;
+
+  _batchedSplineGroupList_.clear();
+  _isBatchedList_.clear();
+  _isBatchedList_.resize( _compressedCache_.dialInterfaceList.size(), false );
+
+  // the spline type, data and input range of a dial. Returns false if the
+  // dial can't be batched.
+  auto fetchSplineFct = [](const DialBase* dialBase_, SplineBatch::Type& type_, const std::vector<double>*& data_,
+                           std::pair<double, double>& bounds_) -> bool {
+    bool allowExtrapolation;
+    if     ( auto* compact = dynamic_cast<const CompactSpline*>(dialBase_) ){
+      type_ = SplineBatch::Type::Compact; bounds_ = compact->getSplineBounds();
+      allowExtrapolation = compact->getAllowExtrapolation();
+    }
+    else if( auto* monotonic = dynamic_cast<const MonotonicSpline*>(dialBase_) ){
+      type_ = SplineBatch::Type::Monotonic; bounds_ = monotonic->getSplineBounds();
+      allowExtrapolation = monotonic->getAllowExtrapolation();
+    }
+    else if( auto* uniform = dynamic_cast<const UniformSpline*>(dialBase_) ){
+      type_ = SplineBatch::Type::Uniform; bounds_ = uniform->getSplineBounds();
+      allowExtrapolation = uniform->getAllowExtrapolation();
+    }
+    else if( auto* general = dynamic_cast<const GeneralSpline*>(dialBase_) ){
+      type_ = SplineBatch::Type::General; bounds_ = general->getSplineBounds();
+      allowExtrapolation = general->getAllowExtrapolation();
+    }
+    else{ return false; }
+
+    data_ = &dialBase_->getDialData();
+    if( allowExtrapolation ){
+      bounds_.first = -std::numeric_limits<double>::infinity();
+      bounds_.second = std::numeric_limits<double>::infinity();
+    }
+    return SplineBatch::getNbKnots(type_, data_->size()) >= 2;
+  };
+
+  std::map<std::tuple<const DialInputBuffer*, const DialResponseSupervisor*, int, int>, size_t> groupIndexDict{};
+  size_t nBatched{0};
+  for( size_t iDial = 0 ; iDial < _compressedCache_.dialInterfaceList.size() ; iDial++ ){
+    auto* dialInterface = _compressedCache_.dialInterfaceList[iDial];
+    if( dialInterface->getInputBufferRef()->getBufferSize() != 1 ){ continue; }
+
+    SplineBatch::Type type;
+    const std::vector<double>* data{nullptr};
+    std::pair<double, double> bounds;
+    if( not fetchSplineFct(dialInterface->getDialBaseRef(), type, data, bounds) ){ continue; }
+
+    int nKnots{SplineBatch::getNbKnots(type, data->size())};
+    auto key = std::make_tuple(
+        static_cast<const DialInputBuffer*>(dialInterface->getInputBufferRef()),
+        dialInterface->getResponseSupervisorRef(), int(type), nKnots
+    );
+    auto it = groupIndexDict.find( key );
+    if( it == groupIndexDict.end() ){
+      it = groupIndexDict.emplace( key, _batchedSplineGroupList_.size() ).first;
+      _batchedSplineGroupList_.emplace_back();
+      _batchedSplineGroupList_.back().inputBuffer = dialInterface->getInputBufferRef();
+      _batchedSplineGroupList_.back().supervisor = dialInterface->getResponseSupervisorRef();
+      _batchedSplineGroupList_.back().group.type = type;
+      _batchedSplineGroupList_.back().group.nKnots = nKnots;
+    }
+
+    auto& batchedGroup = _batchedSplineGroupList_[it->second];
+    batchedGroup.group.addSpline( *data, bounds.first, bounds.second );
+    batchedGroup.tableIndexList.emplace_back( uint32_t(iDial) );
+    _isBatchedList_[iDial] = true;
+    nBatched++;
+  }
+
+  for( auto& batchedGroup : _batchedSplineGroupList_ ){
+    batchedGroup.group.finalize();
+    batchedGroup.responseBuffer.resize( batchedGroup.group.nSplines );
+  }
+
+  LogInfo << nBatched << "/" << _compressedCache_.dialInterfaceList.size() << " dials are evaluated in "
+          << _batchedSplineGroupList_.size() << " spline batches (" << SplineBatch::getSimdLevel() << ")." << std::endl;
+}
+void EventDialCache::beginCompressedCacheRelocation( SampleSet& sampleSet_ ){
+  LogThrowIf( not _useCompressedCache_, "The compressed cache layout is required for the relocation." );
+  auto& source = _compressedCache_;
+  auto& target = _relocatedCompressedCache_;
+
+  // the events of each sample are moved along with their cache entries
+  _relocatedSampleList_.clear();
+  _relocatedEventBeginList_.clear();
+  for( auto& sample : sampleSet_.getSampleList() ){
+    if( size_t(sample.getIndex()) >= _relocatedSampleList_.size() ){
+      _relocatedSampleList_.resize( size_t(sample.getIndex()) + 1, nullptr );
+      _relocatedEventBeginList_.resize( size_t(sample.getIndex()) + 1, nullptr );
+    }
+    _relocatedSampleList_[sample.getIndex()] = &sample.getMcContainer();
+    _relocatedEventBeginList_[sample.getIndex()] = sample.getMcContainer().getEventList().data();
+    sample.getMcContainer().beginEventListRelocation();
+  }
+
+  // no value is written here: the pages will be touched by the workers
+  target = CompressedCache();
+  target.eventList.resize( source.eventList.size() );
+  target.offsetList.resize( source.offsetList.size() );
+  target.dialIndexList.resize( source.dialIndexList.size() );
+  target.responseList.resize( source.responseList.size() );
+  target.responseListFloat.resize( source.responseListFloat.size() );
+
+  // the end offset is not part of any thread range
+  if( not source.offsetList.empty() ){ target.offsetList.back() = source.offsetList.back(); }
+}
+void EventDialCache::relocateCompressedCache( int iThread_ ){
+  auto& source = _compressedCache_;
+  auto& target = _relocatedCompressedCache_;
+
+  auto bounds = GenericToolbox::ParallelWorker::getThreadBoundIndices(
+      iThread_, GundamGlobals::getParallelWorker().getNbThreads(),
+      int(source.eventList.size())
+  );
+  if( bounds.beginIndex >= bounds.endIndex ){ return; }
+
+  for( int iEntry = bounds.beginIndex ; iEntry < bounds.endIndex ; iEntry++ ){
+    auto* event = source.eventList[iEntry];
+    auto* sampleElement = _relocatedSampleList_[event->getIndices().sample];
+    auto iEvent{size_t(event - _relocatedEventBeginList_[event->getIndices().sample])};
+    sampleElement->touchRelocatedEvents( iEvent, iEvent + 1 );
+    target.eventList[iEntry] = sampleElement->getRelocatedEvent( iEvent ); // constructed by endCompressedCacheRelocation()
+  }
+  std::copy( source.offsetList.begin() + bounds.beginIndex, source.offsetList.begin() + bounds.endIndex, target.offsetList.begin() + bounds.beginIndex );
+
+  auto dialBegin{long(source.offsetList[bounds.beginIndex])};
+  auto dialEnd{long(source.offsetList[bounds.endIndex])};
+  std::copy( source.dialIndexList.begin() + dialBegin, source.dialIndexList.begin() + dialEnd, target.dialIndexList.begin() + dialBegin );
+  if( not source.responseList.empty() ){
+    std::copy( source.responseList.begin() + dialBegin, source.responseList.begin() + dialEnd, target.responseList.begin() + dialBegin );
+  }
+  if( not source.responseListFloat.empty() ){
+    std::copy( source.responseListFloat.begin() + dialBegin, source.responseListFloat.begin() + dialEnd, target.responseListFloat.begin() + dialBegin );
+  }
+}
+void EventDialCache::endCompressedCacheRelocation(){
+  for( auto* sampleElement : _relocatedSampleList_ ){
+    if( sampleElement != nullptr ){ sampleElement->endEventListRelocation(); }
+  }
+  _relocatedSampleList_.clear();
+  _relocatedEventBeginList_.clear();
+
+  // shared by all the threads: stays where it is
+  _relocatedCompressedCache_.dialInterfaceList = std::move( _compressedCache_.dialInterfaceList );
+  _relocatedCompressedCache_.dialResponseTable = std::move( _compressedCache_.dialResponseTable );
+  _relocatedCompressedCache_.dialResponseTableFloat = std::move( _compressedCache_.dialResponseTableFloat );
+  _compressedCache_ = std::move( _relocatedCompressedCache_ );
+  _relocatedCompressedCache_ = CompressedCache();
 }
 void EventDialCache::allocateCacheEntries( size_t nEvent_, size_t nDialsMaxPerEvent_) {
     _indexedCache_.resize(
@@ -126,7 +680,70 @@ EventDialCache::IndexedCacheEntry* EventDialCache::fetchNextCacheEntry(){
   LogThrowIf(_fillIndex_ >= _indexedCache_.size());
   return &_indexedCache_[_fillIndex_++];
 }
+EventDialCache::IndexedCacheEntry* EventDialCache::fetchNextCacheEntries(size_t nEntries_){
+  LogThrowIf(_fillIndex_ + nEntries_ > _indexedCache_.size());
+  auto* out{_indexedCache_.data() + _fillIndex_};
+  _fillIndex_ += nEntries_;
+  return out;
+}
+
+
+bool EventDialCache::fillUpdatedEntryList(){
+  _updatedEntryList_.clear();
+
+  if( not _useIncrementalReweight_ ){ return false; }
+  if( _isFullReweightRequested_ ){
+    // the caller is going to reweight everything
+    _isFullReweightRequested_ = false;
+    return false;
+  }
+
+  // a new stamp to flag the entries already in the list
+  _currentStamp_++;
+  if( _currentStamp_ == 0 ){
+    // wrapped around
+    std::fill( _entryStampList_.begin(), _entryStampList_.end(), 0 );
+    _currentStamp_ = 1;
+  }
+
+  auto maxNbUpdatedEntries = size_t( double(this->getNbEntries()) * _incrementalReweightMaxFraction_ );
+  for( size_t iInput = 0 ; iInput < _inputBufferEventIndex_.inputBufferList.size() ; iInput++ ){
+    if( not _inputBufferEventIndex_.inputBufferList[iInput]->isDialUpdateRequested() ){ continue; }
+
+    for( auto& iEntry : _inputBufferEventIndex_.entryIndexList[iInput] ){
+      if( _entryStampList_[iEntry] == _currentStamp_ ){ continue; }
+      _entryStampList_[iEntry] = _currentStamp_;
+      _updatedEntryList_.emplace_back( iEntry );
+    }
+
+    if( _updatedEntryList_.size() > maxNbUpdatedEntries ){
+      // not worth it
+      _updatedEntryList_.clear();
+      return false;
+    }
+  }
+
+  // keep the memory access as sequential as possible
+  std::sort( _updatedEntryList_.begin(), _updatedEntryList_.end() );
+  _updatedEntryPreviousWeightList_.resize( _updatedEntryList_.size() );
+  return true;
+}
+void EventDialCache::reweightUpdatedEntry( size_t iUpdated_ ){
+  size_t iEntry{_updatedEntryList_[iUpdated_]};
+  if( _useCompressedCache_ ){
+    _updatedEntryPreviousWeightList_[iUpdated_] = _compressedCache_.eventList[iEntry]->getWeights().current;
+    this->reweightEntry( iEntry );
+  }
+  else{
+    _updatedEntryPreviousWeightList_[iUpdated_] = _cache_[iEntry].event->getWeights().current;
+    this->reweightEntry( _cache_[iEntry] );
+  }
+}
 
+std::string EventDialCache::getEntrySummary(size_t iEntry_) const{
+  if( _useCompressedCache_ ){ return _compressedCache_.getSummary(iEntry_); }
+  return _cache_[iEntry_].getSummary();
+}
 
 void EventDialCache::reweightEntry( EventDialCache::CacheEntry& entry_){
   // storing the reweight factor in a temporary buffer
@@ -138,9 +755,254 @@ void EventDialCache::reweightEntry( EventDialCache::CacheEntry& entry_){
     tempReweight *= dialResponseCache.getResponse();
   }
 
+  this->applyFactorizedNorm( size_t(&entry_ - _cache_.data()), tempReweight );
+
   // applying event weight cap if defined
   _globalEventReweightCap_.process( tempReweight );
 
   entry_.event->getWeights().resetCurrentWeight(); // reset to the base weight
   entry_.event->getWeights().current *= tempReweight; // apply the reweight factor
 }
+void EventDialCache::reweightEntry( size_t iEntry_ ){
+  double tempReweight{1};
+
+  if( _useDialResponseTable_ ){
+    // responses have already been evaluated: pure gather-multiply
+    const uint32_t* dialIndexPtr{_compressedCache_.dialIndexList.data() + _compressedCache_.offsetList[iEntry_]};
+    const uint32_t* dialIndexEnd{_compressedCache_.dialIndexList.data() + _compressedCache_.getActiveEnd(iEntry_)};
+    if( _useSinglePrecision_ ){
+      // the product is still done in double
+      const float* dialResponseTable{_compressedCache_.dialResponseTableFloat.data()};
+      for( ; dialIndexPtr < dialIndexEnd ; dialIndexPtr++ ){ tempReweight *= double(dialResponseTable[*dialIndexPtr]); }
+    }
+    else{
+      const double* dialResponseTable{_compressedCache_.dialResponseTable.data()};
+      for( ; dialIndexPtr < dialIndexEnd ; dialIndexPtr++ ){ tempReweight *= dialResponseTable[*dialIndexPtr]; }
+    }
+  }
+  else if( _useSinglePrecision_ ){
+    DialInterface* dialInterfacePtr;
+    size_t dialEnd{_compressedCache_.getActiveEnd(iEntry_)};
+    for( size_t iDial = _compressedCache_.offsetList[iEntry_] ; iDial < dialEnd ; iDial++ ){
+      dialInterfacePtr = _compressedCache_.dialInterfaceList[_compressedCache_.dialIndexList[iDial]];
+      if( dialInterfacePtr->getInputBufferRef()->isDialUpdateRequested() ){
+        _compressedCache_.responseListFloat[iDial] = float( dialInterfacePtr->evalResponse() );
+      }
+      tempReweight *= double(_compressedCache_.responseListFloat[iDial]);
+    }
+  }
+  else{
+    // walk the contiguous dial range of this event
+    DialInterface* dialInterfacePtr;
+    size_t dialEnd{_compressedCache_.getActiveEnd(iEntry_)};
+    for( size_t iDial = _compressedCache_.offsetList[iEntry_] ; iDial < dialEnd ; iDial++ ){
+      dialInterfacePtr = _compressedCache_.dialInterfaceList[_compressedCache_.dialIndexList[iDial]];
+      if( dialInterfacePtr->getInputBufferRef()->isDialUpdateRequested() ){
+        _compressedCache_.responseList[iDial] = dialInterfacePtr->evalResponse();
+      }
+      tempReweight *= _compressedCache_.responseList[iDial];
+    }
+  }
+
+  if( not _compressedCache_.foldedReweightList.empty() ){ tempReweight *= _compressedCache_.foldedReweightList[iEntry_]; }
+  this->applyFactorizedNorm( iEntry_, tempReweight );
+  _globalEventReweightCap_.process( tempReweight );
+
+  auto& weights = _compressedCache_.eventList[iEntry_]->getWeights();
+  weights.resetCurrentWeight();
+  weights.current *= tempReweight;
+}
+void EventDialCache::updateFactorizedNormTable(){
+  auto& table = _factorizedNormTable_;
+  for( size_t iCombination = 0 ; iCombination < table.responseList.size() ; iCombination++ ){
+    bool isModified{false};
+    for( size_t iDial = table.offsetList[iCombination] ; iDial < table.offsetList[iCombination+1] ; iDial++ ){
+      auto epoch{table.dialInterfaceList[iDial]->getInputBufferRef()->getEpoch()};
+      if( table.inputEpochList[iDial] != epoch ){ table.inputEpochList[iDial] = epoch; isModified = true; }
+    }
+    if( not isModified ){ continue; }
+
+    double response{1};
+    for( size_t iDial = table.offsetList[iCombination] ; iDial < table.offsetList[iCombination+1] ; iDial++ ){
+      response *= table.dialInterfaceList[iDial]->evalResponse();
+    }
+    table.responseList[iCombination] = response;
+  }
+}
+bool EventDialCache::updateBinNormFactors( SampleSet& sampleSet_ ) const{
+  bool isModified{false};
+  auto& sampleList = sampleSet_.getSampleList();
+  for( auto& binCombination : _factorizedNormTable_.binCombinationList ){
+    auto& mcContainer = sampleList[binCombination.sampleIndex].getMcContainer();
+    double normFactor{_factorizedNormTable_.responseList[binCombination.combination]};
+    if( mcContainer.getHistogram().binList[binCombination.binIndex].normFactor == normFactor ){ continue; }
+    mcContainer.setBinNormFactor(binCombination.binIndex, normFactor);
+    isModified = true;
+  }
+  return isModified;
+}
+bool EventDialCache::updateFoldedDialList(){
+  LogThrowIf( not _useCompressedCache_, "The compressed cache layout is required to fold the dials." );
+
+  // no dial: _isFoldedDialList_ would stay empty and every call would refold
+  if( _compressedCache_.dialInterfaceList.empty() ){ return false; }
+
+  // the folded responses are only valid for the inputs they have been evaluated with
+  bool isModified{false};
+  for( auto& foldedInput : _foldedInputList_ ){
+    if( foldedInput.inputBuffer->isMasked() != foldedInput.isMasked ){ isModified = true; continue; }
+    if( foldedInput.isMasked or foldedInput.inputBuffer->getInputBuffer() == foldedInput.inputList ){ continue; }
+    // the parameter is moved even though it is fixed: don't fold it anymore
+    _releasedInputSet_.insert( foldedInput.inputBuffer );
+    isModified = true;
+  }
+
+  auto isFoldableFct = [&](const DialInputBuffer* inputBuffer_){
+    if( _releasedInputSet_.find( inputBuffer_ ) != _releasedInputSet_.end() ){ return false; }
+    for( int iInput = 0 ; iInput < inputBuffer_->getBufferSize() ; iInput++ ){
+      auto& par = inputBuffer_->getParameter(iInput);
+      if( inputBuffer_->getParameterSet(iInput).isEnabled() and par.isEnabled() and not par.isFixed() ){ return false; }
+    }
+    return true;
+  };
+
+  // a parameter can also be fixed or released in between (fitter stages...)
+  std::vector<const DialInputBuffer*> foldableList{};
+  for( auto* inputBuffer : _inputBufferList_ ){
+    if( isFoldableFct(inputBuffer) ){ foldableList.emplace_back( inputBuffer ); }
+  }
+  if( not isModified and not _isFoldedDialList_.empty() and foldableList.size() == _foldedInputList_.size() ){
+    isModified = not std::equal(
+        foldableList.begin(), foldableList.end(), _foldedInputList_.begin(),
+        [](const DialInputBuffer* inputBuffer_, const FoldedInput& foldedInput_){ return inputBuffer_ == foldedInput_.inputBuffer; }
+    );
+  }
+  else{ isModified = true; }
+  if( not isModified ){ return false; }
+
+  _foldedInputList_.clear();
+  _foldedInputList_.reserve( foldableList.size() );
+  std::unordered_set<const DialInputBuffer*> foldedSet{};
+  for( auto* inputBuffer : foldableList ){
+    _foldedInputList_.emplace_back();
+    _foldedInputList_.back().inputBuffer = inputBuffer;
+    _foldedInputList_.back().isMasked = inputBuffer->isMasked();
+    _foldedInputList_.back().inputList = inputBuffer->getInputBuffer();
+    foldedSet.insert( inputBuffer );
+  }
+
+  auto& dialInterfaceList = _compressedCache_.dialInterfaceList;
+  _isFoldedDialList_.resize( dialInterfaceList.size() );
+  size_t nFoldedDials{0};
+  for( size_t iDial = 0 ; iDial < dialInterfaceList.size() ; iDial++ ){
+    _isFoldedDialList_[iDial] = ( foldedSet.find( dialInterfaceList[iDial]->getInputBufferRef() ) != foldedSet.end() );
+    nFoldedDials += _isFoldedDialList_[iDial];
+  }
+  LogInfo << "Folding " << nFoldedDials << "/" << dialInterfaceList.size() << " dials depending on "
+          << _foldedInputList_.size() << "/" << _inputBufferList_.size() << " inputs that can't move." << std::endl;
+
+  // fresh blocks left uninitialized by the FirstTouchAllocator (a resize
+  // would copy the previous elements): the pages are first written by
+  // foldDials(), from the thread folding each range
+  size_t nEvents{_compressedCache_.eventList.size()};
+  if( _compressedCache_.activeEndList.size() != nEvents ){
+    _compressedCache_.activeEndList = GundamNuma::FirstTouchVector<size_t>( nEvents );
+    _compressedCache_.foldedReweightList = GundamNuma::FirstTouchVector<double>( nEvents );
+  }
+
+  _foldEpoch_++;
+  this->requestFullReweight();
+  return true;
+}
+void EventDialCache::foldDials( int iThread_ ){
+  auto& cache = _compressedCache_;
+
+  // same ranges as the NUMA relocation
+  auto bounds = GenericToolbox::ParallelWorker::getThreadBoundIndices(
+      iThread_, GundamGlobals::getParallelWorker().getNbThreads(),
+      int(cache.eventList.size())
+  );
+
+  // the dials of each event are reordered: the active ones first
+  std::vector<uint32_t> foldedDialBuffer{};
+  for( size_t iEntry = size_t(bounds.beginIndex) ; iEntry < size_t(bounds.endIndex) ; iEntry++ ){
+    foldedDialBuffer.clear();
+    double foldedReweight{1};
+    size_t iActive{cache.offsetList[iEntry]};
+    for( size_t iDial = cache.offsetList[iEntry] ; iDial < cache.offsetList[iEntry+1] ; iDial++ ){
+      uint32_t dialIndex{cache.dialIndexList[iDial]};
+      auto* dialInterface = cache.dialInterfaceList[dialIndex];
+      if( _isFoldedDialList_[dialIndex] ){
+        foldedDialBuffer.emplace_back( dialIndex );
+        foldedReweight *= dialInterface->evalResponse();
+        continue;
+      }
+
+      cache.dialIndexList[iActive] = dialIndex;
+      // the cached response has not been updated while the dial was folded
+      if( not cache.responseList.empty() ){ cache.responseList[iActive] = dialInterface->evalResponse(); }
+      if( not cache.responseListFloat.empty() ){ cache.responseListFloat[iActive] = float( dialInterface->evalResponse() ); }
+      iActive++;
+    }
+    std::copy( foldedDialBuffer.begin(), foldedDialBuffer.end(), cache.dialIndexList.begin() + long(iActive) );
+    cache.activeEndList[iEntry] = iActive;
+    cache.foldedReweightList[iEntry] = foldedReweight;
+  }
+}
+void EventDialCache::updateDialResponseTable( int iThread_ ){
+  auto& dialInterfaceList = _compressedCache_.dialInterfaceList;
+
+  auto bounds = GenericToolbox::ParallelWorker::getThreadBoundIndices(
+      iThread_, GundamGlobals::getParallelWorker().getNbThreads(),
+      int(dialInterfaceList.size())
+  );
+
+  // the thread range is cut along the collections, each having its own
+  // evaluation loop
+  const char* isBatchedList{_isBatchedList_.empty() ? nullptr : _isBatchedList_.data()};
+  for( auto& range : _dialCollectionRangeList_ ){
+    int beginIndex{std::max( int(bounds.beginIndex), int(range.beginIndex) )};
+    int endIndex{std::min( int(bounds.endIndex), int(range.endIndex) )};
+    if( beginIndex >= endIndex ){ continue; }
+
+    if( _useSinglePrecision_ ){
+      evalDialRange( range.typeTag, dialInterfaceList.data(), isBatchedList,
+                     _compressedCache_.dialResponseTableFloat.data(), beginIndex, endIndex );
+    }
+    else{
+      evalDialRange( range.typeTag, dialInterfaceList.data(), isBatchedList,
+                     _compressedCache_.dialResponseTable.data(), beginIndex, endIndex );
+    }
+  }
+
+  // each thread is taking its own slice of every group
+  for( auto& batchedGroup : _batchedSplineGroupList_ ){
+    if( not batchedGroup.inputBuffer->isDialUpdateRequested() ){ continue; }
+
+    auto groupBounds = GenericToolbox::ParallelWorker::getThreadBoundIndices(
+        iThread_, GundamGlobals::getParallelWorker().getNbThreads(),
+        int(batchedGroup.group.nSplines)
+    );
+    if( groupBounds.beginIndex >= groupBounds.endIndex ){ continue; }
+
+    auto* responseBuffer = batchedGroup.responseBuffer.data();
+    if( batchedGroup.inputBuffer->isMasked() ){
+      std::fill( responseBuffer + groupBounds.beginIndex, responseBuffer + groupBounds.endIndex, 1. );
+    }
+    else{
+      SplineBatch::evalGroup(
+          batchedGroup.group, batchedGroup.inputBuffer->getInputBuffer()[0],
+          responseBuffer, size_t(groupBounds.beginIndex), size_t(groupBounds.endIndex)
+      );
+      for( int iSpline = groupBounds.beginIndex ; iSpline < groupBounds.endIndex ; iSpline++ ){
+        responseBuffer[iSpline] = batchedGroup.supervisor->process( responseBuffer[iSpline] );
+      }
+    }
+
+    for( int iSpline = groupBounds.beginIndex ; iSpline < groupBounds.endIndex ; iSpline++ ){
+      uint32_t iDial{batchedGroup.tableIndexList[iSpline]};
+      if( _useSinglePrecision_ ){ _compressedCache_.dialResponseTableFloat[iDial] = float( responseBuffer[iSpline] ); }
+      else{ _compressedCache_.dialResponseTable[iDial] = responseBuffer[iSpline]; }
+    }
+  }
+}
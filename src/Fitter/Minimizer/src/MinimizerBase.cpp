@@ -192,6 +192,9 @@ double MinimizerBase::evalFit( const double* parArray_ ){
       t << _monitor_.externalTimer << GenericToolbox::TablePrinter::NextLine;
 
       ssHeader << t.generateTableString();
+      if( getPropagator().isShowReweightThreadLoad() ){
+        ssHeader << std::endl << "Re-weight threads " << getPropagator().getReweightThreadLoadSummary();
+      }
 
       if( _monitor_.showParameters ){
         std::string curParSet;
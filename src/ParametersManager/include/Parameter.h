@@ -11,6 +11,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 
 class ParameterSet;
@@ -77,13 +78,14 @@ public:
   [[nodiscard]] double getMaxPhysical() const{ return _maxPhysical_; }
   [[nodiscard]] double getStdDevValue() const{ return _stdDevValue_; }
   [[nodiscard]] double getParameterValue() const{ return _parameterValue_; }
+  [[nodiscard]] uint64_t getModificationCounter() const{ return _modificationCounter_; }
   [[nodiscard]] const std::string &getName() const{ return _name_; }
   [[nodiscard]] const JsonType &getDialDefinitionsList() const{ return _dialDefinitionsList_; }
   [[nodiscard]] const ParameterSet *getOwner() const{ return _owner_; }
   [[nodiscard]] PriorType getPriorType() const{ return _priorType_; }
 
   // Core
-  void setValueAtPrior(){ _parameterValue_ = _priorValue_; }
+  void setValueAtPrior(){ if( _parameterValue_ != _priorValue_ ){ _parameterValue_ = _priorValue_; _modificationCounter_++; } }
   void setCurrentValueAsPrior(){ _priorValue_ = _parameterValue_; }
   [[nodiscard]] bool isValueWithinBounds() const;
   [[nodiscard]] double getDistanceFromNominal() const; // in unit of sigmas
@@ -100,6 +102,7 @@ private:
   bool _gotUpdated_{false};
   int _parameterIndex_{-1}; // to get the right definition in the json config (in case "name" is not specified)
   double _parameterValue_{std::nan("unset")};
+  uint64_t _modificationCounter_{0}; // incremented each time the value changes
   double _priorValue_{std::nan("unset")};
   double _throwValue_{std::nan("unset")};
   double _stdDevValue_{std::nan("unset")};
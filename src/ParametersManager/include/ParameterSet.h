@@ -74,6 +74,11 @@ public:
   // Core
   void updateDeltaVector() const;
 
+  /// To be called on a copy of a ParameterSet that lives concurrently with
+  /// the original: the parameters are re-attached to this set, and the
+  /// buffers used by the propagation are not shared anymore.
+  void detachMutableBuffers();
+
   // Throw / Shifts
   void moveParametersToPrior();
   void throwParameters( bool rethrowIfNotInbounds_ = true, double gain_ = 1);
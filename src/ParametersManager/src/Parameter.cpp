@@ -91,6 +91,7 @@ void Parameter::setParameterValue(double parameterValue) {
   if( _parameterValue_ != parameterValue ){
     _gotUpdated_ = true;
     _parameterValue_ = parameterValue;
+    _modificationCounter_++;
   }
   else{ _gotUpdated_ = false; }
 }
@@ -347,6 +347,15 @@ void ParameterSet::updateDeltaVector() const{
   }
 }
 
+void ParameterSet::detachMutableBuffers(){
+  for( auto& par : _parameterList_ ){ par.setOwner(this); }
+  for( auto& eigenPar : _eigenParameterList_ ){ eigenPar.setOwner(this); }
+
+  if( _deltaVectorPtr_ != nullptr ){ _deltaVectorPtr_ = std::make_shared<TVectorD>(*_deltaVectorPtr_); }
+  if( _eigenParBuffer_ != nullptr ){ _eigenParBuffer_ = std::make_shared<TVectorD>(*_eigenParBuffer_); }
+  if( _originalParBuffer_ != nullptr ){ _originalParBuffer_ = std::make_shared<TVectorD>(*_originalParBuffer_); }
+}
+
 // Parameter throw
 void ParameterSet::moveParametersToPrior(){
   LogInfo << "Moving back parameters to their prior value in set: " << getName() << std::endl;
@@ -18,6 +18,8 @@
 #include <vector>
 #include <map>
 #include <future>
+#include <atomic>
+#include <functional>
 
 class Propagator : public JsonBaseClass {
 
@@ -44,13 +46,19 @@ public:
   [[nodiscard]] bool isLoadAsimovData() const { return _loadAsimovData_; }
   [[nodiscard]] bool isShowEventBreakdown() const { return _showEventBreakdown_; }
   [[nodiscard]] bool isDebugPrintLoadedEvents() const { return _debugPrintLoadedEvents_; }
+  [[nodiscard]] bool isDevCheckPropagatorWorker() const { return _devCheckPropagatorWorker_; }
+  [[nodiscard]] bool isShowReweightThreadLoad() const { return _showReweightThreadLoad_; }
+  [[nodiscard]] bool isEnableEigenToOrigInPropagate() const { return _enableEigenToOrigInPropagate_; }
   [[nodiscard]] int getDebugPrintLoadedEventsNbPerSample() const { return _debugPrintLoadedEventsNbPerSample_; }
   [[nodiscard]] int getIThrow() const { return _iThrow_; }
+  [[nodiscard]] double getSinglePrecisionLlhTolerance() const { return _singlePrecisionLlhTolerance_; }
+  [[nodiscard]] size_t getDialCacheBuildCount() const { return _dialCacheBuildCount_; }
   [[nodiscard]] const EventDialCache& getEventDialCache() const { return _eventDialCache_; }
   [[nodiscard]] const ParametersManager &getParametersManager() const { return _parManager_; }
   [[nodiscard]] const std::vector<DialCollection> &getDialCollectionList() const{ return _dialCollectionList_; }
   [[nodiscard]] const SampleSet &getSampleSet() const { return _sampleSet_; }
   [[nodiscard]] const JsonType &getParameterInjectorMc() const { return _parameterInjectorMc_;; }
+  [[nodiscard]] const std::vector<double> &getReweightThreadBusyTimeList() const { return _reweightThreadBusyTimeList_; }
 
   // Non-const getters
   SampleSet &getSampleSet(){ return _sampleSet_; }
@@ -65,10 +73,13 @@ public:
   void resetEventWeights();
   void reweightMcEvents();
   void refillMcHistograms();
+  void reweightAndFillMcHistograms();
   void clearContent();
 
   // Misc
   [[nodiscard]] std::string getSampleBreakdownTableStr() const;
+  [[nodiscard]] std::string getReweightThreadLoadSummary() const;
+  void resetReweightThreadLoad();
   void printBreakdowns();
 
   // Logger related
@@ -77,9 +88,21 @@ public:
 
 protected:
   void initializeThreads();
+  void runReweightJob(const std::string& jobName_);
+  void applyNumaPlacement();
+  [[nodiscard]] int getNumaNode(int iThread_) const; // -1: no placement
+  void updateFoldedDials();
+  void processEntryRanges(int iThread_, size_t nEntries_, const std::function<void(size_t, size_t)>& fct_);
 
   // multithreading
   void reweightMcEvents(int iThread_);
+  void reweightUpdatedMcEvents(int iThread_);
+  void fillIncrementalHistFillBuckets();
+  void refillMcHistogramsIncrementalFct(int iThread_);
+  void initializeFusedHistogramBuffers();
+  void reweightAndFillMcHistogramsFct(int iThread_);
+  void reduceFusedHistogramBuffersFct(int iThread_);
+  void updateDialResponseTable(int iThread_);
   void refillMcHistogramsFct( int iThread_);
 
 private:
@@ -89,6 +112,22 @@ private:
   bool _debugPrintLoadedEvents_{false};
   bool _devSingleThreadReweight_{false};
   bool _devSingleThreadHistFill_{false};
+  bool _devCheckPropagatorWorker_{false};
+  bool _useCompressedDialCache_{false};
+  bool _useDialResponseTable_{false};
+  bool _useBatchedSplineEval_{false};
+  bool _useNormFactorization_{false};
+  bool _useFixedDialFolding_{false};
+  bool _useIncrementalReweight_{false};
+  bool _useIncrementalHistogramFill_{false};
+  double _incrementalReweightMaxFraction_{0.5};
+  int _histogramFullRefillPeriod_{100};
+  bool _useFusedReweightAndFill_{false};
+  bool _showReweightThreadLoad_{false};
+  int _reweightChunkSize_{0};
+  bool _useNumaAwareCache_{false};
+  bool _useSinglePrecisionCache_{false};
+  double _singlePrecisionLlhTolerance_{1E-3};
   int _debugPrintLoadedEventsNbPerSample_{5};
   JsonType _parameterInjectorMc_;
   JsonType _parameterInjectorToy_;
@@ -101,6 +140,27 @@ private:
   bool _showEventBreakdown_{true};
   bool _enableEigenToOrigInPropagate_{true};
   int _iThrow_{-1};
+  size_t _dialCacheBuildCount_{0}; // lets the workers know if the events have been reloaded
+
+  // incremental histogram fill
+  bool _isIncrementalHistFillPossible_{false};
+  int _nIncrementalHistFillSinceFullRefill_{0};
+  size_t _eventWeightsGeneration_{0};
+  size_t _histogramsGeneration_{size_t(-1)};
+  std::vector<std::vector<uint32_t>> _incrementalHistFillBucketList_{}; // updated entries of the bins owned by each thread
+
+  // fused reweight + fill: one (sumW, sumW2) buffer per thread covering all MC bins
+  int _nFusedBuffersInUse_{0};
+  size_t _nFusedBins_{0};
+  std::vector<size_t> _fusedBinOffsetList_{};
+  std::vector<std::vector<double>> _fusedThreadBufferList_{};
+
+  // reweight scheduling: next entry to be processed when chunks are dynamically distributed
+  std::atomic<size_t> _nextEntryChunk_{0};
+  int _nNumaNodes_{0}; // 0: no NUMA placement
+  std::unique_ptr<std::atomic<size_t>[]> _numaNodeNextEntryChunkList_{};
+  size_t _nReweightJobs_{0};
+  std::vector<double> _reweightThreadBusyTimeList_{}; // seconds
 
   // Sub-layers
   SampleSet _sampleSet_{};
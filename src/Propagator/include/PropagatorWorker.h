@@ -0,0 +1,119 @@
+#ifndef GUNDAM_PROPAGATOR_WORKER_H
+#define GUNDAM_PROPAGATOR_WORKER_H
+
+#include "Propagator.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+
+
+/// PropagatorWorker is a lightweight clone of a loaded Propagator. It is
+/// meant to evaluate the MC prediction at a different parameter point than
+/// its owner, concurrently with it or with other workers (parallel scans,
+/// finite differences, multiple MCMC chains...).
+///
+/// The immutable parts are shared with the owner: events, variables, dial
+/// bases, response supervisors and the event-to-dial mapping. A worker only
+/// owns its mutable state: parameter values, dial input buffers, dial
+/// responses, event weights and histograms. The events of the owner are
+/// never written by a worker.
+///
+/// The owner must stay alive and must not reload its data while workers are
+/// being used. A single worker is not meant to be used by several threads.
+/// If the owner folds the dials of fixed parameters, it reorders the dials
+/// of its events whenever a parameter gets fixed or released: the workers
+/// then need to be used in between the propagations of the owner, and are
+/// considered out of sync once the dials have been refolded.
+class PropagatorWorker {
+
+public:
+  explicit PropagatorWorker(const Propagator& owner_);
+
+  // a worker holds pointers to its own members
+  PropagatorWorker(const PropagatorWorker&) = delete;
+  PropagatorWorker& operator=(const PropagatorWorker&) = delete;
+
+  // const getters
+  [[nodiscard]] const Propagator& getOwner() const { return _owner_; }
+  [[nodiscard]] const std::vector<ParameterSet>& getParameterSetList() const { return _parameterSetList_; }
+  [[nodiscard]] const std::vector<Sample>& getSampleList() const { return _sampleList_; }
+  [[nodiscard]] const std::vector<double>& getEventWeightList() const { return _eventWeightList_; }
+
+  /// False if the owner has rebuilt its dial cache, or refolded the dials of
+  /// its events, since this worker was created
+  [[nodiscard]] bool isSynchronizedWithOwner() const {
+    return _ownerDialCacheBuildCount_ == _owner_.getDialCacheBuildCount()
+           and _ownerFoldEpoch_ == _owner_.getEventDialCache().getFoldEpoch();
+  }
+
+  // mutable getters
+  std::vector<ParameterSet>& getParameterSetList(){ return _parameterSetList_; }
+
+  /// The worker equivalent of a parameter of the owner (original or eigen)
+  Parameter& getParameter(const Parameter& ownerParameter_);
+
+  // core
+  /// Copy the current parameter values of the owner
+  void copyParameterValuesFromOwner();
+
+  /// Copy the data histograms of the owner (after a toy throw for instance)
+  void copyDataHistogramsFromOwner();
+
+  /// Reweight the events with the worker parameters and refill the worker histograms
+  void propagateParameters();
+
+  /// Propagate K parameter points with a single pass over the events: the
+  /// dial indices of each event are loaded once, and its K weights are
+  /// accumulated in K histogram buffers. parameterList_ are parameters of
+  /// the owner, and valueBatch_[k] the values they take at the point k. The
+  /// other parameters keep the worker values. Once the pass is done, the
+  /// worker samples and parameters are set to each point in turn and
+  /// onPointReady_(k) is called. The event weights are not stored.
+  void propagateParameterBatch(const std::vector<const Parameter*>& parameterList_,
+                               const std::vector<std::vector<double>>& valueBatch_,
+                               const std::function<void(size_t iPoint_)>& onPointReady_);
+
+protected:
+  void buildDialIndex();
+  void updateDialResponses();
+  void reweightAndFillHistograms();
+  void setBatchPoint(const std::vector<Parameter*>& parameterList_, const std::vector<double>& valueList_);
+  void fillSampleHistograms(const std::vector<double>& sumWeightsBuffer_, const std::vector<double>& normResponseList_);
+  void fillNormResponseList(const std::vector<double>& dialResponseList_, std::vector<double>& normResponseList_) const;
+
+private:
+  const Propagator& _owner_;
+
+  // mutable state of the worker
+  std::vector<ParameterSet> _parameterSetList_{};
+  std::vector<std::vector<DialInputBuffer>> _inputBufferList_{}; // one list per DialCollection
+  std::vector<Sample> _sampleList_{};
+  std::vector<double> _dialResponseList_{};
+  std::vector<double> _normResponseList_{}; // factorized normalisations of the owner
+  std::vector<double> _eventWeightList_{};
+  std::vector<double> _sumWeightsBuffer_{};
+
+  // flat list of the dials: same order as the dial indices of the event index
+  std::vector<const DialInterface*> _dialInterfaceList_{};
+  std::vector<DialInputBuffer*> _dialInputBufferList_{};
+
+  // event to dial mapping: shared with the owner if it uses the compressed
+  // layout, built once otherwise
+  const EventDialCache::CompressedCache* _eventIndexPtr_{nullptr};
+  EventDialCache::CompressedCache _ownEventIndex_{};
+  std::vector<size_t> _sampleBinOffsetList_{};
+  size_t _ownerDialCacheBuildCount_{0};
+  size_t _ownerFoldEpoch_{0};
+
+  // batched propagation: one entry per point
+  std::vector<std::vector<double>> _batchDialResponseList_{};
+  std::vector<std::vector<double>> _batchNormResponseList_{};
+  std::vector<std::vector<double>> _batchSumWeightsBuffer_{};
+
+};
+
+
+#endif //GUNDAM_PROPAGATOR_WORKER_H
@@ -10,6 +10,8 @@
 
 #include "ParameterSet.h"
 #include "GundamGlobals.h"
+#include "GundamNuma.h"
+#include "GundamCompensatedSum.h"
 #include "ConfigUtils.h"
 
 #include "GenericToolbox.Utils.h"
@@ -17,6 +19,9 @@
 
 #include <memory>
 #include <vector>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
 
 LoggerInit([]{
   Logger::setUserHeaderStr("[Propagator]");
@@ -61,8 +66,53 @@ void Propagator::readConfigImpl(){
   _debugPrintLoadedEventsNbPerSample_ = GenericToolbox::Json::fetchValue(_config_, "debugPrintLoadedEventsNbPerSample", _debugPrintLoadedEventsNbPerSample_);
   _devSingleThreadReweight_ = GenericToolbox::Json::fetchValue(_config_, "devSingleThreadReweight", _devSingleThreadReweight_);
   _devSingleThreadHistFill_ = GenericToolbox::Json::fetchValue(_config_, "devSingleThreadHistFill", _devSingleThreadHistFill_);
+  _devCheckPropagatorWorker_ = GenericToolbox::Json::fetchValue(_config_, "devCheckPropagatorWorker", _devCheckPropagatorWorker_);
 
   // EventDialCache parameters
+  _useCompressedDialCache_ = GenericToolbox::Json::fetchValue(_config_, "useCompressedDialCache", _useCompressedDialCache_);
+  _useDialResponseTable_ = GenericToolbox::Json::fetchValue(_config_, "useDialResponseTable", _useDialResponseTable_);
+  if( _useDialResponseTable_ and not _useCompressedDialCache_ ){
+    LogAlert << "useDialResponseTable requires the compressed dial cache. Enabling useCompressedDialCache." << std::endl;
+    _useCompressedDialCache_ = true;
+  }
+  _useBatchedSplineEval_ = GenericToolbox::Json::fetchValue(_config_, "useBatchedSplineEval", _useBatchedSplineEval_);
+  if( _useBatchedSplineEval_ and not _useDialResponseTable_ ){
+    LogAlert << "useBatchedSplineEval requires the dial response table. Enabling useDialResponseTable." << std::endl;
+    _useDialResponseTable_ = true;
+    _useCompressedDialCache_ = true;
+  }
+  _useNumaAwareCache_ = GenericToolbox::Json::fetchValue(_config_, "useNumaAwareCache", _useNumaAwareCache_);
+  if( _useNumaAwareCache_ and not _useCompressedDialCache_ ){
+    LogAlert << "useNumaAwareCache requires the compressed dial cache. Enabling useCompressedDialCache." << std::endl;
+    _useCompressedDialCache_ = true;
+  }
+  _useSinglePrecisionCache_ = GenericToolbox::Json::fetchValue(_config_, "useSinglePrecisionCache", _useSinglePrecisionCache_);
+  _singlePrecisionLlhTolerance_ = GenericToolbox::Json::fetchValue(_config_, "singlePrecisionLlhTolerance", _singlePrecisionLlhTolerance_);
+  if( _useSinglePrecisionCache_ and not _useCompressedDialCache_ ){
+    LogAlert << "useSinglePrecisionCache requires the compressed dial cache. Enabling useCompressedDialCache." << std::endl;
+    _useCompressedDialCache_ = true;
+  }
+  _useNormFactorization_ = GenericToolbox::Json::fetchValue(_config_, "useNormFactorization", _useNormFactorization_);
+  _useFixedDialFolding_ = GenericToolbox::Json::fetchValue(_config_, "useFixedDialFolding", _useFixedDialFolding_);
+  if( _useFixedDialFolding_ and not _useCompressedDialCache_ ){
+    LogAlert << "useFixedDialFolding requires the compressed dial cache. Enabling useCompressedDialCache." << std::endl;
+    _useCompressedDialCache_ = true;
+  }
+  _useIncrementalReweight_ = GenericToolbox::Json::fetchValue(_config_, "useIncrementalReweight", _useIncrementalReweight_);
+  _incrementalReweightMaxFraction_ = GenericToolbox::Json::fetchValue(_config_, "incrementalReweightMaxFraction", _incrementalReweightMaxFraction_);
+  _useIncrementalHistogramFill_ = GenericToolbox::Json::fetchValue(_config_, "useIncrementalHistogramFill", _useIncrementalHistogramFill_);
+  _histogramFullRefillPeriod_ = GenericToolbox::Json::fetchValue(_config_, "histogramFullRefillPeriod", _histogramFullRefillPeriod_);
+  _useFusedReweightAndFill_ = GenericToolbox::Json::fetchValue(_config_, "useFusedReweightAndFill", _useFusedReweightAndFill_);
+  _reweightChunkSize_ = GenericToolbox::Json::fetchValue(_config_, "reweightChunkSize", _reweightChunkSize_);
+  _showReweightThreadLoad_ = GenericToolbox::Json::fetchValue(_config_, "showReweightThreadLoad", _showReweightThreadLoad_);
+  if( _useFusedReweightAndFill_ and _useIncrementalReweight_ ){
+    LogAlert << "useFusedReweightAndFill always reweights all the events. Disabling useIncrementalReweight." << std::endl;
+    _useIncrementalReweight_ = false;
+  }
+  if( _useIncrementalHistogramFill_ and not _useIncrementalReweight_ ){
+    LogAlert << "useIncrementalHistogramFill requires useIncrementalReweight. Disabling incremental histogram fill." << std::endl;
+    _useIncrementalHistogramFill_ = false;
+  }
   if( GenericToolbox::Json::doKeyExist(_config_, "globalEventReweightCap") ){
     _eventDialCache_.getGlobalEventReweightCap().isEnabled = true;
     _eventDialCache_.getGlobalEventReweightCap().maxReweight = GenericToolbox::Json::fetchValue<double>(_config_, "globalEventReweightCap");
@@ -141,15 +191,66 @@ void Propagator::initializeImpl(){
 
 // Core
 void Propagator::buildDialCache(){
+  bool useCompressedDialCache{_useCompressedDialCache_};
+#ifdef GUNDAM_USING_CACHE_MANAGER
+  if( useCompressedDialCache and GundamGlobals::getEnableCacheManager() ){
+    // the Cache::Manager is reading the per event dial lists
+    LogAlert << "useCompressedDialCache is not compatible with the Cache::Manager. Using the standard layout." << std::endl;
+    useCompressedDialCache = false;
+  }
+  if( _useIncrementalHistogramFill_ and GundamGlobals::getEnableCacheManager() ){
+    // the histograms are filled from the Cache::Manager buffers
+    LogAlert << "useIncrementalHistogramFill is not compatible with the Cache::Manager. Disabling it." << std::endl;
+    _useIncrementalHistogramFill_ = false;
+  }
+  if( _useFusedReweightAndFill_ and GundamGlobals::getEnableCacheManager() ){
+    LogAlert << "useFusedReweightAndFill is not compatible with the Cache::Manager. Disabling it." << std::endl;
+    _useFusedReweightAndFill_ = false;
+  }
+  if( _useNormFactorization_ and GundamGlobals::getEnableCacheManager() ){
+    // the Cache::Manager is reading the per event dial lists
+    LogAlert << "useNormFactorization is not compatible with the Cache::Manager. Disabling it." << std::endl;
+    _useNormFactorization_ = false;
+  }
+  if( GundamGlobals::getEnableCacheManager() ){
+    // the Cache::Manager is uploading the double precision data blocks
+    for( auto& dialCollection : _dialCollectionList_ ){
+      LogThrowIf( dialCollection.isUseFloatKnots(),
+                  "useFloatKnots is not compatible with the Cache::Manager: " << dialCollection.getTitle() );
+      LogThrowIf( dialCollection.isUseTabulatedResponse(),
+                  "useTabulatedResponse is not compatible with the Cache::Manager: " << dialCollection.getTitle() );
+    }
+  }
+#endif
+  _eventDialCache_.setUseCompressedCache( useCompressedDialCache );
+  _eventDialCache_.setUseDialResponseTable( useCompressedDialCache and _useDialResponseTable_ );
+  _eventDialCache_.setUseIncrementalReweight( _useIncrementalReweight_ );
+  _eventDialCache_.setUseSinglePrecision( useCompressedDialCache and _useSinglePrecisionCache_ );
+  _eventDialCache_.setUseBatchedSplines( useCompressedDialCache and _useBatchedSplineEval_ );
+  _eventDialCache_.setIncrementalReweightMaxFraction( _incrementalReweightMaxFraction_ );
+  _eventDialCache_.setUseNormFactorization( _useNormFactorization_ );
+  _eventDialCache_.setUseFixedDialFolding( useCompressedDialCache and _useFixedDialFolding_ );
+
   _eventDialCache_.shrinkIndexedCache();
   _eventDialCache_.buildReferenceCache(_sampleSet_, _dialCollectionList_);
 
+  _nNumaNodes_ = 0;
+  if( useCompressedDialCache and _useNumaAwareCache_ ){ this->applyNumaPlacement(); }
+  _dialCacheBuildCount_++;
+
+  // the rounding errors of the float responses should not pile up in the bins
+  for( auto& sample : _sampleSet_.getSampleList() ){
+    sample.getMcContainer().setUseCompensatedSummation( _eventDialCache_.isUseSinglePrecision() );
+  }
+
   // be extra sure the dial input will request an update
   for( auto& dialCollection : _dialCollectionList_ ){
     for( auto& dialInput : dialCollection.getDialInputBufferList() ){
       dialInput.invalidateBuffers();
     }
   }
+
+  if( _useFusedReweightAndFill_ ){ this->initializeFusedHistogramBuffers(); }
 }
 void Propagator::propagateParameters(){
 
@@ -160,6 +261,11 @@ void Propagator::propagateParameters(){
     }
   }
 
+  if( _useFusedReweightAndFill_ ){
+    this->reweightAndFillMcHistograms();
+    return;
+  }
+
   this->reweightMcEvents();
   this->refillMcHistograms();
 
@@ -175,27 +281,109 @@ void Propagator::reweightMcEvents() {
   resetEventWeights();
 
   bool usedGPU{false};
+  _isIncrementalHistFillPossible_ = false;
 #ifdef GUNDAM_USING_CACHE_MANAGER
   if( GundamGlobals::getEnableCacheManager() ) {
     Cache::Manager::Update(getSampleSet(), getEventDialCache());
     usedGPU = Cache::Manager::Fill();
     if (GundamGlobals::getForceDirectCalculation()) usedGPU = false;
+    // CPU weights are not up-to-date anymore
+    if( usedGPU ){ _eventDialCache_.requestFullReweight(); }
   }
 #endif
   if( not usedGPU ){
+    if( _eventDialCache_.isUseFixedDialFolding() ){ this->updateFoldedDials(); }
+
+    // only the events depending on the updated parameters?
+    bool isIncremental{_eventDialCache_.fillUpdatedEntryList()};
+
+    // deltas can only be applied on top of histograms filled with the previous weights
+    _isIncrementalHistFillPossible_ = (
+        _useIncrementalHistogramFill_ and isIncremental
+        and _histogramsGeneration_ == _eventWeightsGeneration_
+    );
+
+    _eventDialCache_.updateFactorizedNormTable();
+    // a bin whose normalisation has changed needs to be refilled
+    if( _eventDialCache_.updateBinNormFactors( _sampleSet_ ) ){ _isIncrementalHistFillPossible_ = false; }
+
     if( not _devSingleThreadReweight_ ){
-      GundamGlobals::getParallelWorker().runJob("Propagator::reweightMcEvents");
+      if( _eventDialCache_.isUseDialResponseTable() ){
+        GundamGlobals::getParallelWorker().runJob("Propagator::updateDialResponseTable");
+      }
+      if( isIncremental ){
+        if( not _eventDialCache_.getUpdatedEntryList().empty() ){
+          this->runReweightJob("Propagator::reweightUpdatedMcEvents");
+        }
+      }
+      else{ this->runReweightJob("Propagator::reweightMcEvents"); }
+    }
+    else{
+      if( _eventDialCache_.isUseDialResponseTable() ){ this->updateDialResponseTable(-1); }
+      if( isIncremental ){ this->reweightUpdatedMcEvents(-1); }
+      else{ this->reweightMcEvents(-1); }
     }
-    else{ this->reweightMcEvents(-1); }
   }
 
+  _eventWeightsGeneration_++;
   reweightTimer.stop();
 }
 void Propagator::refillMcHistograms(){
   refillHistogramTimer.start();
 
-  if( not _devSingleThreadHistFill_ ){ GundamGlobals::getParallelWorker().runJob("Propagator::refillMcHistograms"); }
-  else{ refillMcHistogramsFct(-1); }
+  // periodic full refill to bound the floating point drift of the deltas
+  if( _isIncrementalHistFillPossible_ and _nIncrementalHistFillSinceFullRefill_ < _histogramFullRefillPeriod_ ){
+    _nIncrementalHistFillSinceFullRefill_++;
+    this->fillIncrementalHistFillBuckets();
+    if( not _devSingleThreadHistFill_ ){ GundamGlobals::getParallelWorker().runJob("Propagator::refillMcHistogramsIncremental"); }
+    else{ refillMcHistogramsIncrementalFct(-1); }
+  }
+  else{
+    _nIncrementalHistFillSinceFullRefill_ = 0;
+    if( not _devSingleThreadHistFill_ ){ GundamGlobals::getParallelWorker().runJob("Propagator::refillMcHistograms"); }
+    else{ refillMcHistogramsFct(-1); }
+  }
+
+  _histogramsGeneration_ = _eventWeightsGeneration_;
+  _isIncrementalHistFillPossible_ = false;
+  refillHistogramTimer.stop();
+}
+void Propagator::updateFoldedDials(){
+  // only when a parameter has been fixed, released or moved anyway
+  if( not _eventDialCache_.updateFoldedDialList() ){ return; }
+  if( not _devSingleThreadReweight_ ){ GundamGlobals::getParallelWorker().runJob("Propagator::foldDials"); }
+  else{ _eventDialCache_.foldDials(-1); }
+}
+void Propagator::reweightAndFillMcHistograms(){
+  // the events are streamed only once: each thread reweights its share of
+  // the cache and directly accumulates the weights in its own bin buffer
+  reweightTimer.start();
+
+  resetEventWeights();
+  if( _eventDialCache_.isUseFixedDialFolding() ){ this->updateFoldedDials(); }
+  _eventDialCache_.updateFactorizedNormTable();
+  _eventDialCache_.updateBinNormFactors( _sampleSet_ );
+  if( _eventDialCache_.isUseDialResponseTable() ){
+    if( not _devSingleThreadReweight_ ){ GundamGlobals::getParallelWorker().runJob("Propagator::updateDialResponseTable"); }
+    else{ this->updateDialResponseTable(-1); }
+  }
+
+  if( not _devSingleThreadReweight_ ){
+    _nFusedBuffersInUse_ = GundamGlobals::getParallelWorker().getNbThreads();
+    this->runReweightJob("Propagator::reweightAndFillMcHistograms");
+  }
+  else{
+    _nFusedBuffersInUse_ = 1;
+    this->reweightAndFillMcHistogramsFct(-1);
+  }
+  _eventWeightsGeneration_++;
+
+  reweightTimer.stop();
+  refillHistogramTimer.start();
+
+  if( not _devSingleThreadHistFill_ ){ GundamGlobals::getParallelWorker().runJob("Propagator::reduceFusedHistogramBuffers"); }
+  else{ this->reduceFusedHistogramBuffersFct(-1); }
+  _histogramsGeneration_ = _eventWeightsGeneration_;
 
   refillHistogramTimer.stop();
 }
@@ -215,6 +403,7 @@ void Propagator::clearContent(){
     }
   }
   _eventDialCache_ = EventDialCache();
+  _histogramsGeneration_ = size_t(-1);
 
 }
 
@@ -301,26 +490,156 @@ void Propagator::printBreakdowns(){
       LogDebug << "Event #" << iEvt << "{" << std::endl;
       {
         LogScopeIndent;
-        LogDebug << _eventDialCache_.getCache()[iEvt].getSummary() << std::endl;
+        LogDebug << _eventDialCache_.getEntrySummary(iEvt) << std::endl;
       }
       LogDebug << "}" << std::endl;
     }
   }
 }
 
+std::string Propagator::getReweightThreadLoadSummary() const{
+  std::stringstream ss;
+  if( _reweightThreadBusyTimeList_.empty() or _nReweightJobs_ == 0 ){ ss << "no reweight job has been run"; return ss.str(); }
+
+  auto minMax = std::minmax_element( _reweightThreadBusyTimeList_.begin(), _reweightThreadBusyTimeList_.end() );
+  double mean = std::accumulate( _reweightThreadBusyTimeList_.begin(), _reweightThreadBusyTimeList_.end(), double(0) );
+  mean /= double(_reweightThreadBusyTimeList_.size());
+
+  // times per reweight job
+  double toMs{1E3 / double(_nReweightJobs_)};
+  ss << "busy time per thread: mean " << mean * toMs << " ms";
+  ss << ", min " << *minMax.first * toMs << " ms";
+  ss << ", max " << *minMax.second * toMs << " ms";
+  if( mean > 0 ){ ss << " (max/mean: " << *minMax.second / mean << ")"; }
+  return ss.str();
+}
+void Propagator::resetReweightThreadLoad(){
+  _nReweightJobs_ = 0;
+  std::fill( _reweightThreadBusyTimeList_.begin(), _reweightThreadBusyTimeList_.end(), 0 );
+}
+
 // Protected
 void Propagator::initializeThreads() {
 
+  _reweightThreadBusyTimeList_.clear();
+  _reweightThreadBusyTimeList_.resize( GundamGlobals::getParallelWorker().getNbThreads(), 0 );
+
   GundamGlobals::getParallelWorker().addJob(
       "Propagator::reweightMcEvents",
       [this](int iThread){ this->reweightMcEvents(iThread); }
   );
 
+  GundamGlobals::getParallelWorker().addJob(
+      "Propagator::reweightUpdatedMcEvents",
+      [this](int iThread){ this->reweightUpdatedMcEvents(iThread); }
+  );
+
+  GundamGlobals::getParallelWorker().addJob(
+      "Propagator::updateDialResponseTable",
+      [this](int iThread){ this->updateDialResponseTable(iThread); }
+  );
+
+  GundamGlobals::getParallelWorker().addJob(
+      "Propagator::foldDials",
+      [this](int iThread){ _eventDialCache_.foldDials(iThread); }
+  );
+
   GundamGlobals::getParallelWorker().addJob(
       "Propagator::refillMcHistograms",
       [this](int iThread){ this->refillMcHistogramsFct(iThread); }
   );
 
+  GundamGlobals::getParallelWorker().addJob(
+      "Propagator::refillMcHistogramsIncremental",
+      [this](int iThread){ this->refillMcHistogramsIncrementalFct(iThread); }
+  );
+
+  GundamGlobals::getParallelWorker().addJob(
+      "Propagator::reweightAndFillMcHistograms",
+      [this](int iThread){ this->reweightAndFillMcHistogramsFct(iThread); }
+  );
+
+  GundamGlobals::getParallelWorker().addJob(
+      "Propagator::reduceFusedHistogramBuffers",
+      [this](int iThread){ this->reduceFusedHistogramBuffersFct(iThread); }
+  );
+
+  GundamGlobals::getParallelWorker().addJob(
+      "Propagator::relocateEventDialCache",
+      [this](int iThread){
+        // the pages are placed on the node of the thread first touching them
+        GundamNuma::ThreadAffinityGuard affinityGuard{ this->getNumaNode(iThread) };
+        _eventDialCache_.relocateCompressedCache(iThread);
+      }
+  );
+
+}
+
+void Propagator::applyNumaPlacement(){
+  int nThreads{GundamGlobals::getParallelWorker().getNbThreads()};
+  int nNodes{std::min(GundamNuma::getNbNodes(), nThreads)};
+  LogInfo << "NUMA placement of the event dial cache and MC events: " << nThreads << " threads over " << nNodes << " node(s)" << std::endl;
+
+  // the worker threads of a given node are processing one contiguous slab of
+  // the cache and of the events: each thread touches its own slab first
+  _nNumaNodes_ = nNodes;
+  _eventDialCache_.beginCompressedCacheRelocation( _sampleSet_ );
+  GundamGlobals::getParallelWorker().runJob("Propagator::relocateEventDialCache");
+  _eventDialCache_.endCompressedCacheRelocation();
+
+  _numaNodeNextEntryChunkList_ = std::make_unique<std::atomic<size_t>[]>( size_t(nNodes) );
+}
+int Propagator::getNumaNode(int iThread_) const{
+  if( _nNumaNodes_ <= 1 or iThread_ == -1 ){ return -1; }
+  return GundamNuma::getThreadNode(iThread_, GundamGlobals::getParallelWorker().getNbThreads(), _nNumaNodes_);
+}
+void Propagator::runReweightJob(const std::string& jobName_){
+  _nextEntryChunk_ = 0;
+  for( int iNode = 0 ; iNode < _nNumaNodes_ ; iNode++ ){ _numaNodeNextEntryChunkList_[iNode] = 0; }
+  GundamGlobals::getParallelWorker().runJob(jobName_);
+  _nReweightJobs_++;
+}
+void Propagator::processEntryRanges(int iThread_, size_t nEntries_, const std::function<void(size_t, size_t)>& fct_){
+  auto startTime = std::chrono::steady_clock::now();
+
+  // only the reweight and fill jobs run on the node holding their slab
+  GundamNuma::ThreadAffinityGuard affinityGuard{ this->getNumaNode(iThread_) };
+
+  if( iThread_ == -1 or _reweightChunkSize_ <= 0 ){
+    // static scheduling: one contiguous range per thread
+    auto bounds = GenericToolbox::ParallelWorker::getThreadBoundIndices(
+        iThread_, GundamGlobals::getParallelWorker().getNbThreads(), int(nEntries_)
+    );
+    fct_( size_t(bounds.beginIndex), size_t(bounds.endIndex) );
+  }
+  else{
+    // dynamic scheduling: the cost of an event depends on its dials, so
+    // threads keep fetching chunks until the whole range has been processed
+    auto chunkSize{size_t(_reweightChunkSize_)};
+    size_t rangeBegin{0};
+    size_t rangeEnd{nEntries_};
+    auto* nextChunk{&_nextEntryChunk_};
+
+    if( _nNumaNodes_ > 1 ){
+      // only steal work within the slab of the node
+      int nThreads{GundamGlobals::getParallelWorker().getNbThreads()};
+      int iNode{GundamNuma::getThreadNode(iThread_, nThreads, _nNumaNodes_)};
+      auto nodeThreads{GundamNuma::getNodeThreadRange(iNode, nThreads, _nNumaNodes_)};
+      rangeBegin = size_t(GenericToolbox::ParallelWorker::getThreadBoundIndices(nodeThreads.first, nThreads, int(nEntries_)).beginIndex);
+      rangeEnd = size_t(GenericToolbox::ParallelWorker::getThreadBoundIndices(nodeThreads.second - 1, nThreads, int(nEntries_)).endIndex);
+      nextChunk = &_numaNodeNextEntryChunkList_[iNode];
+    }
+
+    size_t beginIndex{rangeBegin + nextChunk->fetch_add(chunkSize, std::memory_order_relaxed)};
+    while( beginIndex < rangeEnd ){
+      fct_( beginIndex, std::min(beginIndex + chunkSize, rangeEnd) );
+      beginIndex = rangeBegin + nextChunk->fetch_add(chunkSize, std::memory_order_relaxed);
+    }
+  }
+
+  if( iThread_ != -1 ){
+    _reweightThreadBusyTimeList_[iThread_] += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  }
 }
 
 // multithreading
@@ -329,23 +648,134 @@ void Propagator::reweightMcEvents(int iThread_) {
   //! Warning: everything you modify here, may significantly slow down the
   //! fitter
 
-  auto bounds = GenericToolbox::ParallelWorker::getThreadBoundIndices(
-      iThread_, GundamGlobals::getParallelWorker().getNbThreads(),
-      int(_eventDialCache_.getCache().size())
-  );
+  if( _eventDialCache_.isUseCompressedCache() ){
+    processEntryRanges(iThread_, _eventDialCache_.getNbEntries(), [this](size_t beginIndex_, size_t endIndex_){
+      for( size_t iEntry = beginIndex_ ; iEntry < endIndex_ ; iEntry++ ){
+        _eventDialCache_.reweightEntry(iEntry);
+      }
+    });
+    return;
+  }
 
-  std::for_each(
-      _eventDialCache_.getCache().begin() + bounds.beginIndex,
-      _eventDialCache_.getCache().begin() + bounds.endIndex,
-      [this]( EventDialCache::CacheEntry& cache_){ _eventDialCache_.reweightEntry(cache_); }
-  );
+  processEntryRanges(iThread_, _eventDialCache_.getNbEntries(), [this](size_t beginIndex_, size_t endIndex_){
+    std::for_each(
+        _eventDialCache_.getCache().begin() + long(beginIndex_),
+        _eventDialCache_.getCache().begin() + long(endIndex_),
+        [this]( EventDialCache::CacheEntry& cache_){ _eventDialCache_.reweightEntry(cache_); }
+    );
+  });
 
 }
+void Propagator::reweightUpdatedMcEvents(int iThread_){
+  processEntryRanges(iThread_, _eventDialCache_.getUpdatedEntryList().size(), [this](size_t beginIndex_, size_t endIndex_){
+    for( size_t iUpdated = beginIndex_ ; iUpdated < endIndex_ ; iUpdated++ ){
+      _eventDialCache_.reweightUpdatedEntry( iUpdated );
+    }
+  });
+}
+void Propagator::updateDialResponseTable(int iThread_){
+  _eventDialCache_.updateDialResponseTable(iThread_);
+}
 void Propagator::refillMcHistogramsFct( int iThread_){
   for( auto& sample : _sampleSet_.getSampleList() ){
     sample.getMcContainer().refillHistogram(iThread_);
   }
 }
+void Propagator::fillIncrementalHistFillBuckets(){
+  // bins are distributed among threads the same way as refillHistogram() does
+  size_t nThreads{_devSingleThreadHistFill_ ? 1 : size_t(GundamGlobals::getParallelWorker().getNbThreads())};
+  _incrementalHistFillBucketList_.resize( nThreads );
+  for( auto& bucket : _incrementalHistFillBucketList_ ){ bucket.clear(); }
+
+  auto& updatedEntryList = _eventDialCache_.getUpdatedEntryList();
+  for( size_t iUpdated = 0 ; iUpdated < updatedEntryList.size() ; iUpdated++ ){
+    int iBin{_eventDialCache_.getEntryEventPtr( updatedEntryList[iUpdated] )->getIndices().bin};
+    if( iBin < 0 ){ continue; }
+    _incrementalHistFillBucketList_[size_t(iBin) % nThreads].emplace_back( uint32_t(iUpdated) );
+  }
+}
+void Propagator::refillMcHistogramsIncrementalFct( int iThread_){
+  if( iThread_ == -1 ){ iThread_ = 0; }
+
+  auto& updatedEntryList = _eventDialCache_.getUpdatedEntryList();
+  auto& previousWeightList = _eventDialCache_.getUpdatedEntryPreviousWeightList();
+  auto& sampleList = _sampleSet_.getSampleList();
+
+  // only the entries falling in the bins of this thread
+  for( auto iUpdated : _incrementalHistFillBucketList_[iThread_] ){
+    auto* eventPtr = _eventDialCache_.getEntryEventPtr( updatedEntryList[iUpdated] );
+    int iBin{eventPtr->getIndices().bin};
+    sampleList[eventPtr->getIndices().sample].getMcContainer().applyEventWeightDelta(
+        iBin, previousWeightList[iUpdated], eventPtr->getWeights().current
+    );
+  }
+
+  for( auto& sample : sampleList ){
+    sample.getMcContainer().updateBinErrors(iThread_);
+  }
+}
+void Propagator::initializeFusedHistogramBuffers(){
+  LogInfo << "Allocating the per-thread histogram buffers for the fused reweight..." << std::endl;
+
+  _nFusedBins_ = 0;
+  _fusedBinOffsetList_.clear();
+  _fusedBinOffsetList_.reserve( _sampleSet_.getSampleList().size() );
+  for( auto& sample : _sampleSet_.getSampleList() ){
+    // events are referring to their sample using its index in the list
+    LogThrowIf( sample.getIndex() != int(_fusedBinOffsetList_.size()), "Unexpected sample index: " << sample.getIndex() );
+    _fusedBinOffsetList_.emplace_back( _nFusedBins_ );
+    _nFusedBins_ += sample.getMcContainer().getHistogram().nBins;
+  }
+
+  // interleaved (sumW, sumW2) -> both are updated together
+  _fusedThreadBufferList_.clear();
+  _fusedThreadBufferList_.resize( GundamGlobals::getParallelWorker().getNbThreads(), std::vector<double>(2*_nFusedBins_, 0) );
+  LogInfo << _fusedThreadBufferList_.size() << " buffers of " << _nFusedBins_ << " bins allocated." << std::endl;
+}
+void Propagator::reweightAndFillMcHistogramsFct(int iThread_){
+
+  //! Warning: everything you modify here, may significantly slow down the
+  //! fitter
+
+  auto& buffer = _fusedThreadBufferList_[ iThread_ == -1 ? 0 : iThread_ ];
+  std::fill( buffer.begin(), buffer.end(), 0 );
+
+  bool isCompressed{_eventDialCache_.isUseCompressedCache()};
+  processEntryRanges(iThread_, _eventDialCache_.getNbEntries(), [&](size_t beginIndex_, size_t endIndex_){
+    for( size_t iEntry = beginIndex_ ; iEntry < endIndex_ ; iEntry++ ){
+      if( isCompressed ){ _eventDialCache_.reweightEntry( iEntry ); }
+      else{ _eventDialCache_.reweightEntry( _eventDialCache_.getCache()[iEntry] ); }
+
+      auto* eventPtr = _eventDialCache_.getEntryEventPtr( iEntry );
+      if( eventPtr->getIndices().bin < 0 ){ continue; }
+
+      double weight{eventPtr->getWeights().current};
+      double* binBuffer = &buffer[2*(_fusedBinOffsetList_[eventPtr->getIndices().sample] + eventPtr->getIndices().bin)];
+      binBuffer[0] += weight;
+      binBuffer[1] += weight * weight;
+    }
+  });
+}
+void Propagator::reduceFusedHistogramBuffersFct(int iThread_){
+  int nThreads = GundamGlobals::getParallelWorker().getNbThreads();
+  if( iThread_ == -1 ){ nThreads = 1; iThread_ = 0; }
+
+  auto& sampleList = _sampleSet_.getSampleList();
+  for( size_t iSample = 0 ; iSample < sampleList.size() ; iSample++ ){
+    auto& mcContainer = sampleList[iSample].getMcContainer();
+    for( int iBin = iThread_ ; iBin < mcContainer.getHistogram().nBins ; iBin += nThreads ){
+      size_t iBuffer{2*(_fusedBinOffsetList_[iSample] + iBin)};
+      GundamUtils::CompensatedSum sumW{};
+      GundamUtils::CompensatedSum sumW2{};
+      for( int iThreadBuffer = 0 ; iThreadBuffer < _nFusedBuffersInUse_ ; iThreadBuffer++ ){
+        sumW.add( _fusedThreadBufferList_[iThreadBuffer][iBuffer] );
+        sumW2.add( _fusedThreadBufferList_[iThreadBuffer][iBuffer+1] );
+      }
+      double normFactor{mcContainer.getHistogram().binList[iBin].normFactor};
+      mcContainer.setBinContent(iBin, sumW.get() * normFactor, sumW2.get() * (normFactor * normFactor));
+    }
+  }
+}
 
 //  A Lesser GNU Public License
 
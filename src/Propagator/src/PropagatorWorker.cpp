@@ -0,0 +1,311 @@
+#include "PropagatorWorker.h"
+
+#include "Logger.h"
+
+#include <limits>
+#include <algorithm>
+
+LoggerInit([]{
+  Logger::setUserHeaderStr("[PropagatorWorker]");
+});
+
+
+PropagatorWorker::PropagatorWorker(const Propagator& owner_) : _owner_(owner_) {
+  _ownerDialCacheBuildCount_ = _owner_.getDialCacheBuildCount();
+  _ownerFoldEpoch_ = _owner_.getEventDialCache().getFoldEpoch();
+
+  // parameters: values are copied, buffers are not shared
+  _parameterSetList_ = _owner_.getParametersManager().getParameterSetsList();
+  for( auto& parSet : _parameterSetList_ ){ parSet.detachMutableBuffers(); }
+
+  // input buffers are now pointing to the worker parameters
+  _inputBufferList_.reserve( _owner_.getDialCollectionList().size() );
+  for( auto& dialCollection : _owner_.getDialCollectionList() ){
+    _inputBufferList_.emplace_back( dialCollection.getDialInputBufferList() );
+    for( auto& inputBuffer : _inputBufferList_.back() ){
+      inputBuffer.setParSetRef( &_parameterSetList_ );
+      inputBuffer.invalidateBuffers();
+    }
+  }
+
+  // samples without their events
+  _sampleList_.resize( _owner_.getSampleSet().getSampleList().size() );
+  size_t nBins{0};
+  for( size_t iSample = 0 ; iSample < _sampleList_.size() ; iSample++ ){
+    auto& ownerSample = _owner_.getSampleSet().getSampleList()[iSample];
+    LogThrowIf( ownerSample.getIndex() != int(iSample), "Unexpected sample index: " << ownerSample.getIndex() );
+    _sampleList_[iSample].copyWithoutEvents( ownerSample );
+    _sampleBinOffsetList_.emplace_back( nBins );
+    nBins += size_t( ownerSample.getMcContainer().getHistogram().nBins );
+  }
+  _sumWeightsBuffer_.resize( 2*nBins, 0 );
+
+  this->buildDialIndex();
+}
+
+Parameter& PropagatorWorker::getParameter(const Parameter& ownerParameter_){
+  auto& ownerParSetList = _owner_.getParametersManager().getParameterSetsList();
+  auto iParSet = size_t( ownerParameter_.getOwner() - ownerParSetList.data() );
+  LogThrowIf( ownerParameter_.getOwner() == nullptr or iParSet >= ownerParSetList.size(),
+              "Parameter not handled by the owner propagator: " << ownerParameter_.getFullTitle() );
+
+  auto& parSet = _parameterSetList_[iParSet];
+  if( ownerParameter_.isEigen() ){ return parSet.getEigenParameterList()[ownerParameter_.getParameterIndex()]; }
+  return parSet.getParameterList()[ownerParameter_.getParameterIndex()];
+}
+void PropagatorWorker::copyParameterValuesFromOwner(){
+  auto& ownerParSetList = _owner_.getParametersManager().getParameterSetsList();
+  for( size_t iParSet = 0 ; iParSet < _parameterSetList_.size() ; iParSet++ ){
+    auto& parList = _parameterSetList_[iParSet].getParameterList();
+    for( size_t iPar = 0 ; iPar < parList.size() ; iPar++ ){
+      parList[iPar].setParameterValue( ownerParSetList[iParSet].getParameterList()[iPar].getParameterValue() );
+    }
+    auto& eigenParList = _parameterSetList_[iParSet].getEigenParameterList();
+    for( size_t iEigen = 0 ; iEigen < eigenParList.size() ; iEigen++ ){
+      eigenParList[iEigen].setParameterValue( ownerParSetList[iParSet].getEigenParameterList()[iEigen].getParameterValue() );
+    }
+  }
+}
+void PropagatorWorker::copyDataHistogramsFromOwner(){
+  for( size_t iSample = 0 ; iSample < _sampleList_.size() ; iSample++ ){
+    _sampleList_[iSample].getDataContainer().copyHistogram( _owner_.getSampleSet().getSampleList()[iSample].getDataContainer() );
+  }
+}
+void PropagatorWorker::propagateParameters(){
+  LogThrowIf( not this->isSynchronizedWithOwner(), "The owner propagator has rebuilt or refolded its dial cache: create a new worker." );
+
+  if( _owner_.isEnableEigenToOrigInPropagate() ){
+    for( auto& parSet : _parameterSetList_ ){
+      if( parSet.isEnableEigenDecomp() ){ parSet.propagateEigenToOriginal(); }
+    }
+  }
+
+  for( auto& inputBufferList : _inputBufferList_ ){
+    for( auto& inputBuffer : inputBufferList ){ inputBuffer.update(); }
+  }
+
+  this->updateDialResponses();
+  this->reweightAndFillHistograms();
+}
+
+void PropagatorWorker::buildDialIndex(){
+
+  // worker input buffer associated to each input buffer of the owner
+  std::unordered_map<const DialInputBuffer*, DialInputBuffer*> inputBufferMap{};
+  auto& dialCollectionList = _owner_.getDialCollectionList();
+  for( size_t iCollection = 0 ; iCollection < dialCollectionList.size() ; iCollection++ ){
+    auto& ownerInputBufferList = dialCollectionList[iCollection].getDialInputBufferList();
+    for( size_t iInput = 0 ; iInput < ownerInputBufferList.size() ; iInput++ ){
+      inputBufferMap[&ownerInputBufferList[iInput]] = &_inputBufferList_[iCollection][iInput];
+    }
+  }
+
+  auto& eventDialCache = _owner_.getEventDialCache();
+  if( eventDialCache.isUseCompressedCache() ){
+    // nothing to build: the CSR layout is read-only during the propagation
+    _eventIndexPtr_ = &eventDialCache.getCompressedCache();
+  }
+  else{
+    LogInfo << "Building the event index of the worker..." << std::endl;
+
+    std::unordered_map<const DialInterface*, uint32_t> dialIndexMap{};
+    for( auto& dialCollection : dialCollectionList ){
+      for( auto& dialInterface : dialCollection.getDialInterfaceList() ){
+        dialIndexMap[&dialInterface] = uint32_t( _ownEventIndex_.dialInterfaceList.size() );
+        _ownEventIndex_.dialInterfaceList.emplace_back( const_cast<DialInterface*>(&dialInterface) );
+      }
+    }
+    LogThrowIf( _ownEventIndex_.dialInterfaceList.size() >= size_t(std::numeric_limits<uint32_t>::max()),
+                "Too many dial interfaces for the worker index." );
+
+    _ownEventIndex_.eventList.reserve( eventDialCache.getCache().size() );
+    _ownEventIndex_.offsetList.reserve( eventDialCache.getCache().size() + 1 );
+    _ownEventIndex_.offsetList.emplace_back( 0 );
+    for( auto& cacheEntry : eventDialCache.getCache() ){
+      _ownEventIndex_.eventList.emplace_back( cacheEntry.event );
+      for( auto& dialResponseCache : cacheEntry.dialResponseCacheList ){
+        _ownEventIndex_.dialIndexList.emplace_back( dialIndexMap.at( &dialResponseCache.dialInterface ) );
+      }
+      _ownEventIndex_.offsetList.emplace_back( _ownEventIndex_.dialIndexList.size() );
+    }
+
+    _eventIndexPtr_ = &_ownEventIndex_;
+  }
+
+  _dialInterfaceList_.reserve( _eventIndexPtr_->dialInterfaceList.size() );
+  _dialInputBufferList_.reserve( _eventIndexPtr_->dialInterfaceList.size() );
+  for( auto* dialInterface : _eventIndexPtr_->dialInterfaceList ){
+    _dialInterfaceList_.emplace_back( dialInterface );
+    _dialInputBufferList_.emplace_back( inputBufferMap.at( dialInterface->getInputBufferRef() ) );
+  }
+  _dialResponseList_.resize( _dialInterfaceList_.size(), std::nan("unset") );
+  _eventWeightList_.resize( _eventIndexPtr_->eventList.size(), 0 );
+}
+void PropagatorWorker::updateDialResponses(){
+  // each dial is evaluated once with the worker input buffers
+  for( size_t iDial = 0 ; iDial < _dialInterfaceList_.size() ; iDial++ ){
+    if( not _dialInputBufferList_[iDial]->isDialUpdateRequested() ){ continue; }
+    _dialResponseList_[iDial] = DialInterface::evalResponse(
+        _dialInputBufferList_[iDial],
+        _dialInterfaceList_[iDial]->getDialBaseRef(),
+        _dialInterfaceList_[iDial]->getResponseSupervisorRef()
+    );
+  }
+}
+void PropagatorWorker::fillNormResponseList(const std::vector<double>& dialResponseList_, std::vector<double>& normResponseList_) const{
+  // same flat dial indexing as the event index
+  auto& normTable = _owner_.getEventDialCache().getFactorizedNormTable();
+  normResponseList_.resize( normTable.getNbCombinations() );
+  for( size_t iCombination = 0 ; iCombination < normTable.getNbCombinations() ; iCombination++ ){
+    double response{1};
+    for( size_t iDial = normTable.offsetList[iCombination] ; iDial < normTable.offsetList[iCombination+1] ; iDial++ ){
+      response *= dialResponseList_[normTable.dialIndexList[iDial]];
+    }
+    normResponseList_[iCombination] = response;
+  }
+}
+void PropagatorWorker::reweightAndFillHistograms(){
+  auto& eventIndex = *_eventIndexPtr_;
+  auto& reweightCap = _owner_.getEventDialCache().getGlobalEventReweightCap();
+  auto& entryCombinationList = _owner_.getEventDialCache().getFactorizedNormTable().entryCombinationList;
+
+  std::fill( _sumWeightsBuffer_.begin(), _sumWeightsBuffer_.end(), 0 );
+  this->fillNormResponseList( _dialResponseList_, _normResponseList_ );
+
+  for( size_t iEntry = 0 ; iEntry < eventIndex.eventList.size() ; iEntry++ ){
+    double reweight{1};
+    for( size_t iDial = eventIndex.offsetList[iEntry] ; iDial < eventIndex.offsetList[iEntry+1] ; iDial++ ){
+      reweight *= _dialResponseList_[eventIndex.dialIndexList[iDial]];
+    }
+    if( not entryCombinationList.empty() and entryCombinationList[iEntry] != EventDialCache::FactorizedNormTable::noCombination ){
+      reweight *= _normResponseList_[entryCombinationList[iEntry]];
+    }
+    reweightCap.process( reweight );
+
+    // the event itself is only read
+    const Event* eventPtr = eventIndex.eventList[iEntry];
+    _eventWeightList_[iEntry] = eventPtr->getWeights().base * reweight;
+
+    if( eventPtr->getIndices().bin < 0 ){ continue; }
+    double* binBuffer = &_sumWeightsBuffer_[2*(_sampleBinOffsetList_[eventPtr->getIndices().sample] + eventPtr->getIndices().bin)];
+    binBuffer[0] += _eventWeightList_[iEntry];
+    binBuffer[1] += _eventWeightList_[iEntry] * _eventWeightList_[iEntry];
+  }
+
+  this->fillSampleHistograms( _sumWeightsBuffer_, _normResponseList_ );
+}
+void PropagatorWorker::fillSampleHistograms(const std::vector<double>& sumWeightsBuffer_, const std::vector<double>& normResponseList_){
+  for( size_t iSample = 0 ; iSample < _sampleList_.size() ; iSample++ ){
+    auto& mcContainer = _sampleList_[iSample].getMcContainer();
+    for( int iBin = 0 ; iBin < mcContainer.getHistogram().nBins ; iBin++ ){
+      size_t iBuffer{2*(_sampleBinOffsetList_[iSample] + iBin)};
+      mcContainer.setBinContent( iBin, sumWeightsBuffer_[iBuffer], sumWeightsBuffer_[iBuffer+1] );
+    }
+  }
+
+  // binned normalisations are applied after the fill, as the owner does
+  for( auto& binCombination : _owner_.getEventDialCache().getFactorizedNormTable().binCombinationList ){
+    auto& mcContainer = _sampleList_[binCombination.sampleIndex].getMcContainer();
+    double normFactor{normResponseList_[binCombination.combination]};
+    auto& bin = mcContainer.getHistogram().binList[binCombination.binIndex];
+    mcContainer.setBinContent( binCombination.binIndex, bin.content * normFactor, bin.sumW2 * (normFactor * normFactor) );
+  }
+}
+void PropagatorWorker::setBatchPoint(const std::vector<Parameter*>& parameterList_, const std::vector<double>& valueList_){
+  for( size_t iPar = 0 ; iPar < parameterList_.size() ; iPar++ ){
+    parameterList_[iPar]->setParameterValue( valueList_[iPar] );
+  }
+  if( _owner_.isEnableEigenToOrigInPropagate() ){
+    for( auto& parSet : _parameterSetList_ ){
+      if( parSet.isEnableEigenDecomp() ){ parSet.propagateEigenToOriginal(); }
+    }
+  }
+}
+void PropagatorWorker::propagateParameterBatch(
+    const std::vector<const Parameter*>& parameterList_,
+    const std::vector<std::vector<double>>& valueBatch_,
+    const std::function<void(size_t iPoint_)>& onPointReady_){
+
+  LogThrowIf( not this->isSynchronizedWithOwner(), "The owner propagator has rebuilt or refolded its dial cache: create a new worker." );
+
+  size_t nPoints{valueBatch_.size()};
+  if( nPoints == 0 ){ return; }
+
+  std::vector<Parameter*> workerParameterList{};
+  workerParameterList.reserve( parameterList_.size() );
+  for( auto* ownerPar : parameterList_ ){ workerParameterList.emplace_back( &this->getParameter(*ownerPar) ); }
+  for( auto& valueList : valueBatch_ ){
+    LogThrowIf( valueList.size() != parameterList_.size(),
+                "Expecting " << parameterList_.size() << " values per point, got " << valueList.size() );
+  }
+
+  _batchDialResponseList_.resize( nPoints );
+  _batchSumWeightsBuffer_.resize( nPoints );
+  _batchNormResponseList_.resize( nPoints );
+
+  // dial responses of every point. Only the dials whose inputs have moved
+  // since the previous point are evaluated.
+  for( size_t iPoint = 0 ; iPoint < nPoints ; iPoint++ ){
+    this->setBatchPoint( workerParameterList, valueBatch_[iPoint] );
+    for( auto& inputBufferList : _inputBufferList_ ){
+      for( auto& inputBuffer : inputBufferList ){ inputBuffer.update(); }
+    }
+
+    auto& responseList = _batchDialResponseList_[iPoint];
+    responseList = ( iPoint == 0 ? _dialResponseList_ : _batchDialResponseList_[iPoint-1] );
+    for( size_t iDial = 0 ; iDial < _dialInterfaceList_.size() ; iDial++ ){
+      if( not _dialInputBufferList_[iDial]->isDialUpdateRequested() ){ continue; }
+      responseList[iDial] = DialInterface::evalResponse(
+          _dialInputBufferList_[iDial],
+          _dialInterfaceList_[iDial]->getDialBaseRef(),
+          _dialInterfaceList_[iDial]->getResponseSupervisorRef()
+      );
+    }
+
+    this->fillNormResponseList( responseList, _batchNormResponseList_[iPoint] );
+
+    _batchSumWeightsBuffer_[iPoint].resize( _sumWeightsBuffer_.size() );
+    std::fill( _batchSumWeightsBuffer_[iPoint].begin(), _batchSumWeightsBuffer_[iPoint].end(), 0 );
+  }
+
+  // the input buffers are now in sync with the last point
+  _dialResponseList_ = _batchDialResponseList_.back();
+
+  // event-major pass
+  auto& eventIndex = *_eventIndexPtr_;
+  auto& reweightCap = _owner_.getEventDialCache().getGlobalEventReweightCap();
+  auto& entryCombinationList = _owner_.getEventDialCache().getFactorizedNormTable().entryCombinationList;
+  std::vector<double> reweightList(nPoints);
+  for( size_t iEntry = 0 ; iEntry < eventIndex.eventList.size() ; iEntry++ ){
+    const Event* eventPtr = eventIndex.eventList[iEntry];
+    if( eventPtr->getIndices().bin < 0 ){ continue; }
+
+    std::fill( reweightList.begin(), reweightList.end(), 1 );
+    for( size_t iDial = eventIndex.offsetList[iEntry] ; iDial < eventIndex.offsetList[iEntry+1] ; iDial++ ){
+      uint32_t dialIndex{eventIndex.dialIndexList[iDial]};
+      for( size_t iPoint = 0 ; iPoint < nPoints ; iPoint++ ){
+        reweightList[iPoint] *= _batchDialResponseList_[iPoint][dialIndex];
+      }
+    }
+    if( not entryCombinationList.empty() and entryCombinationList[iEntry] != EventDialCache::FactorizedNormTable::noCombination ){
+      for( size_t iPoint = 0 ; iPoint < nPoints ; iPoint++ ){
+        reweightList[iPoint] *= _batchNormResponseList_[iPoint][entryCombinationList[iEntry]];
+      }
+    }
+
+    size_t iBuffer{2*(_sampleBinOffsetList_[eventPtr->getIndices().sample] + eventPtr->getIndices().bin)};
+    for( size_t iPoint = 0 ; iPoint < nPoints ; iPoint++ ){
+      reweightCap.process( reweightList[iPoint] );
+      double weight{eventPtr->getWeights().base * reweightList[iPoint]};
+      _batchSumWeightsBuffer_[iPoint][iBuffer] += weight;
+      _batchSumWeightsBuffer_[iPoint][iBuffer+1] += weight * weight;
+    }
+  }
+
+  for( size_t iPoint = 0 ; iPoint < nPoints ; iPoint++ ){
+    // parameters are needed for the penalty term
+    this->setBatchPoint( workerParameterList, valueBatch_[iPoint] );
+    this->fillSampleHistograms( _batchSumWeightsBuffer_[iPoint], _batchNormResponseList_[iPoint] );
+    onPointReady_( iPoint );
+  }
+}
@@ -48,6 +48,7 @@ namespace EventUtils{
 
       template<typename T>void set(const T& value_){ var = value_; updateCache(); }
       void set(const GenericToolbox::LeafForm& leafForm_);
+      void set(const Variable& other_); // same type expected: raw copy of the content
       [[nodiscard]] const GenericToolbox::AnyType& get() const { return var; }
       [[nodiscard]] double getVarAsDouble() const { return cache; }
 
@@ -79,6 +80,7 @@ namespace EventUtils{
     // memory
     void allocateMemory( const std::vector<const GenericToolbox::LeafForm*>& leafFormList_);
     void copyData( const std::vector<const GenericToolbox::LeafForm*>& leafFormList_);
+    void copyData( const Variables& other_);
 
     // fetch
     [[nodiscard]] int findVarIndex( const std::string& leafName_, bool throwIfNotFound_ = true) const;
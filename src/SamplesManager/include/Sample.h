@@ -54,6 +54,10 @@ public:
   // Misc
   bool isDatasetValid(const std::string& datasetName_);
 
+  /// Copy the definition, binning and histograms of another sample, but not
+  /// its events. Used by the lightweight propagator workers.
+  void copyWithoutEvents(const Sample& other_);
+
 private:
   // Yaml
   bool _isEnabled_{false};
@@ -29,6 +29,8 @@ public:
       int index{-1};
       double content{0};
       double error{0};
+      double sumW2{0}; // kept for incremental updates: error = sqrt(sumW2)
+      double normFactor{1}; // binned normalisation applied to the content instead of the event weights
       const DataBin* dataBinPtr{nullptr};
       std::vector<Event*> eventPtrList{};
     };
@@ -41,12 +43,20 @@ public:
 
   // setters
   void setName(const std::string& name_){ _name_ = name_; }
+  void setUseCompensatedSummation(bool useCompensatedSummation_){ _useCompensatedSummation_ = useCompensatedSummation_; }
 
   // const-getters
+  [[nodiscard]] bool isUseCompensatedSummation() const{ return _useCompensatedSummation_; }
   [[nodiscard]] const std::string& getName() const{ return _name_; }
   [[nodiscard]] const std::vector<Event> &getEventList() const{ return _eventList_; }
   [[nodiscard]] const Histogram &getHistogram() const{ return _histogram_; }
 
+  /// Weight of an event including the normalisation of its bin
+  [[nodiscard]] double getEventWeight(const Event& event_) const{
+    if( event_.getIndices().bin < 0 ){ return event_.getEventWeight(); }
+    return event_.getEventWeight() * _histogram_.binList[event_.getIndices().bin].normFactor;
+  }
+
   // mutable-getters
   std::vector<Event> &getEventList(){ return _eventList_; }
 
@@ -54,9 +64,27 @@ public:
   void buildHistogram(const DataBinSet& binning_);
   void reserveEventMemory(size_t dataSetIndex_, size_t nEvents, const Event &eventBuffer_);
   void shrinkEventList(size_t newTotalSize_);
+
+  // NUMA placement: the events are moved into a new allocation whose pages
+  // have been first touched by the threads that are going to reweight them
+  void beginEventListRelocation();
+  [[nodiscard]] Event* getRelocatedEvent(size_t iEvent_){ return _relocatedEventList_.data() + iEvent_; }
+  void touchRelocatedEvents(size_t beginIndex_, size_t endIndex_);
+  void endEventListRelocation();
   void updateBinEventList(int iThread_ = -1);
   void refillHistogram(int iThread_ = -1);
 
+  // incremental histogram update -> only the events that have been reweighted
+  void applyEventWeightDelta(int iBin_, double previousWeight_, double newWeight_);
+  void updateBinErrors(int iThread_ = -1);
+
+  // for histograms filled outside refillHistogram() (fused reweight + fill)
+  void setBinContent(int iBin_, double sumW_, double sumW2_);
+  void setBinNormFactor(int iBin_, double normFactor_){ _histogram_.binList[iBin_].normFactor = normFactor_; }
+
+  // copy the histogram content without the event references (lightweight copies)
+  void copyHistogram(const SampleElement& other_);
+
   // event by event poisson throw -> takes into account the finite amount of stat in MC
   void throwEventMcError();
 
@@ -72,9 +100,11 @@ public:
   friend std::ostream& operator <<( std::ostream& o, const SampleElement& this_ );
 
 private:
+  bool _useCompensatedSummation_{false}; // Kahan summation of the bin contents
   std::string _name_{};
   Histogram _histogram_{};
   std::vector<Event> _eventList_{};
+  std::vector<Event> _relocatedEventList_{}; // reserved, not constructed
   std::vector<DatasetProperties> _loadedDatasetList_{};
 
 #ifdef GUNDAM_USING_CACHE_MANAGER
@@ -51,6 +51,13 @@ namespace EventUtils{
     );
     updateCache();
   }
+  void Variables::Variable::set(const Variable& other_){
+    memcpy(
+        var.getPlaceHolderPtr()->getVariableAddress(),
+        other_.var.getPlaceHolderPtr()->getVariableAddress(), other_.var.getPlaceHolderPtr()->getVariableSize()
+    );
+    updateCache();
+  }
 
   void Variables::setVarNameList( const std::shared_ptr<std::vector<std::string>> &nameListPtr_ ){
     LogThrowIf(nameListPtr_ == nullptr, "Invalid commonNameListPtr_ provided.");
@@ -75,6 +82,12 @@ namespace EventUtils{
       _varList_[iLeaf].set( *leafFormList_[iLeaf] );
     }
   }
+  void Variables::copyData( const Variables& other_){
+    size_t nVar{other_._varList_.size()};
+    for( size_t iVar = 0 ; iVar < nVar ; iVar++ ){
+      _varList_[iVar].set( other_._varList_[iVar] );
+    }
+  }
 
   int Variables::findVarIndex( const std::string& leafName_, bool throwIfNotFound_) const{
     LogThrowIf(_nameListPtr_ == nullptr, "Can't " << __METHOD_NAME__ << " while _commonLeafNameListPtr_ is empty.");
@@ -156,6 +156,9 @@ void PlotGenerator::generateSampleHistograms(TDirectory *saveDir_, int cacheSlot
           }
         }
 
+        // binned normalisations are held by the container, not the event weights
+        const auto& container = ( isData ? sample.getDataContainer() : sample.getMcContainer() );
+
         // Filling the selected histograms
         std::function<void(int)> fillJob = [&]( int iThread_ ){
 
@@ -169,7 +172,7 @@ void PlotGenerator::generateSampleHistograms(TDirectory *saveDir_, int cacheSlot
             for( int iBin = bounds.beginIndex+1 ; iBin <= bounds.endIndex ; iBin++ ){
               hist->histPtr->SetBinContent(iBin, 0);
               for( auto* evtPtr : hist->_binEventPtrList_[iBin-1] ){
-                hist->histPtr->AddBinContent(iBin, evtPtr->getEventWeight());
+                hist->histPtr->AddBinContent(iBin, container.getEventWeight(*evtPtr));
               }
               hist->histPtr->SetBinError(iBin, TMath::Sqrt(hist->histPtr->GetBinContent(iBin)));
             }
@@ -50,6 +50,21 @@ void Sample::initializeImpl() {
   _dataContainer_.buildHistogram(_binning_);
 }
 
+void Sample::copyWithoutEvents(const Sample& other_){
+  _isEnabled_ = other_._isEnabled_;
+  _index_ = other_._index_;
+  _name_ = other_._name_;
+  _selectionCutStr_ = other_._selectionCutStr_;
+  _binningConfig_ = other_._binningConfig_;
+  _enabledDatasetList_ = other_._enabledDatasetList_;
+  _llhStatBuffer_ = other_._llhStatBuffer_;
+  _binning_ = other_._binning_;
+  _dataSetIndexList_ = other_._dataSetIndexList_;
+
+  // the bins are still referring to the DataBin of the original sample
+  _mcContainer_.copyHistogram( other_._mcContainer_ );
+  _dataContainer_.copyHistogram( other_._dataContainer_ );
+}
 bool Sample::isDatasetValid(const std::string& datasetName_){
   if( _enabledDatasetList_.empty() ) return true;
   for( auto& dataSetName : _enabledDatasetList_){
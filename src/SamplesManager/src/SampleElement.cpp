@@ -4,6 +4,7 @@
 
 #include "GundamGlobals.h"
 #include "GundamAlmostEqual.h"
+#include "GundamCompensatedSum.h"
 
 #include "SampleElement.h"
 
@@ -12,6 +13,8 @@
 #include "TRandom.h"
 
 #include <cmath>
+#include <iterator>
+#include <algorithm>
 
 LoggerInit([]{ Logger::setUserHeaderStr("[SampleElement]"); });
 
@@ -64,6 +67,28 @@ void SampleElement::shrinkEventList(size_t newTotalSize_){
   _eventList_.resize(newTotalSize_);
   _eventList_.shrink_to_fit();
 }
+void SampleElement::beginEventListRelocation(){
+  // capacity only: none of the pages is touched here
+  _relocatedEventList_ = std::vector<Event>();
+  _relocatedEventList_.reserve( _eventList_.size() );
+}
+void SampleElement::touchRelocatedEvents(size_t beginIndex_, size_t endIndex_){
+  // the objects are constructed later: only the raw storage is written
+  if( beginIndex_ >= endIndex_ ){ return; }
+  auto* begin = reinterpret_cast<unsigned char*>( _relocatedEventList_.data() + beginIndex_ );
+  auto* end = reinterpret_cast<unsigned char*>( _relocatedEventList_.data() + endIndex_ );
+  std::fill( begin, end, (unsigned char) 0 );
+}
+void SampleElement::endEventListRelocation(){
+  // within the capacity: the events land where their pages have been placed
+  _relocatedEventList_.insert(
+      _relocatedEventList_.end(),
+      std::make_move_iterator( _eventList_.begin() ),
+      std::make_move_iterator( _eventList_.end() )
+  );
+  _eventList_.swap( _relocatedEventList_ );
+  _relocatedEventList_ = std::vector<Event>();
+}
 void SampleElement::updateBinEventList(int iThread_) {
   int nbThreads = GundamGlobals::getParallelWorker().getNbThreads();
   if( iThread_ == -1 ){ iThread_ = 0; nbThreads = 1; }
@@ -125,7 +150,18 @@ void SampleElement::refillHistogram(int iThread_){
       filledWithManager = true;
     }
 #endif
-    if (not binFilled) {
+    if (not binFilled and _useCompensatedSummation_) {
+      GundamUtils::CompensatedSum sumW{};
+      GundamUtils::CompensatedSum sumW2{};
+      for (auto *eventPtr: binPtr->eventPtrList) {
+        buffer = eventPtr->getEventWeight();
+        sumW.add( buffer );
+        sumW2.add( buffer * buffer );
+      }
+      binPtr->content = sumW.get();
+      binPtr->error = sumW2.get();
+    }
+    else if (not binFilled) {
       binPtr->content = 0;
       binPtr->error = 0;
       for (auto *eventPtr: binPtr->eventPtrList) {
@@ -134,6 +170,11 @@ void SampleElement::refillHistogram(int iThread_){
         binPtr->error += buffer * buffer;
       }
     }
+    if( not binFilled ){
+      // binned normalisation left out of the event weights
+      binPtr->content *= binPtr->normFactor;
+      binPtr->error *= binPtr->normFactor * binPtr->normFactor;
+    }
 #ifdef GUNDAM_USING_CACHE_MANAGER
     // Parallel calculations of the histogramming have been run.  Make sure
     // they are the same.
@@ -145,11 +186,51 @@ void SampleElement::refillHistogram(int iThread_){
                  << " Error: " << error << "!=" << binPtr->error);
     }
 #endif
+    binPtr->sumW2 = binPtr->error;
     binPtr->error = std::sqrt(binPtr->error);
     iBin += nThreads;
   }
 
 }
+void SampleElement::applyEventWeightDelta(int iBin_, double previousWeight_, double newWeight_){
+  // the caller has to make sure a given bin is only handled by one thread
+  auto& bin = _histogram_.binList[iBin_];
+  bin.content += bin.normFactor * (newWeight_ - previousWeight_);
+  bin.sumW2 += bin.normFactor * bin.normFactor * (newWeight_ * newWeight_ - previousWeight_ * previousWeight_);
+}
+void SampleElement::setBinContent(int iBin_, double sumW_, double sumW2_){
+  auto& bin = _histogram_.binList[iBin_];
+  bin.content = sumW_;
+  bin.sumW2 = sumW2_;
+  bin.error = std::sqrt(sumW2_);
+}
+void SampleElement::copyHistogram(const SampleElement& other_){
+  _name_ = other_._name_;
+  _histogram_.nBins = other_._histogram_.nBins;
+  _histogram_.binList.clear();
+  _histogram_.binList.reserve( other_._histogram_.binList.size() );
+  for( auto& otherBin : other_._histogram_.binList ){
+    _histogram_.binList.emplace_back();
+    auto& bin = _histogram_.binList.back();
+    bin.index = otherBin.index;
+    bin.content = otherBin.content;
+    bin.error = otherBin.error;
+    bin.sumW2 = otherBin.sumW2;
+    bin.normFactor = otherBin.normFactor;
+    bin.dataBinPtr = otherBin.dataBinPtr;
+  }
+}
+void SampleElement::updateBinErrors(int iThread_){
+  int nThreads = GundamGlobals::getParallelWorker().getNbThreads();
+  if( iThread_ == -1 ){ nThreads = 1; iThread_ = 0; }
+
+  for( int iBin = iThread_ ; iBin < _histogram_.nBins ; iBin += nThreads ){
+    auto& bin = _histogram_.binList[iBin];
+    // rounding could make it slightly negative
+    if( bin.sumW2 < 0 ){ bin.sumW2 = 0; }
+    bin.error = std::sqrt(bin.sumW2);
+  }
+}
 
 void SampleElement::throwEventMcError(){
   /*
@@ -163,7 +244,7 @@ void SampleElement::throwEventMcError(){
       eventPtr->getWeights().current = (gRandom->Poisson(1) * eventPtr->getEventWeight());
       weightSum += eventPtr->getEventWeight();
     }
-    bin.content = weightSum;
+    bin.content = weightSum * bin.normFactor;
   }
 }
 void SampleElement::throwStatError(bool useGaussThrow_){
@@ -192,7 +273,7 @@ void SampleElement::throwStatError(bool useGaussThrow_){
 
 double SampleElement::getSumWeights() const{
   double output = std::accumulate(_eventList_.begin(), _eventList_.end(), double(0.),
-                                  [](double sum_, const Event& ev_){ return sum_ + ev_.getEventWeight(); });
+                                  [this](double sum_, const Event& ev_){ return sum_ + this->getEventWeight(ev_); });
   return output;
 }
 size_t SampleElement::getNbBinnedEvents() const{
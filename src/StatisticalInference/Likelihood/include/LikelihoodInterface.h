@@ -8,6 +8,7 @@
 #include "ParameterSet.h"
 #include "JointProbability.h"
 #include "Propagator.h"
+#include "PropagatorWorker.h"
 #include "DataSetManager.h"
 
 #include "GenericToolbox.Utils.h"
@@ -62,14 +63,37 @@ public:
   // mutable core
   void propagateAndEvalLikelihood();
 
+  /// Evaluate the likelihood at K parameter points with one pass over the
+  /// events. parameterList_ are parameters of the propagator, and
+  /// valueBatch_[k] the values they take at point k. The other parameters
+  /// are taken at their current value. The propagator itself is left
+  /// untouched, as well as the internal buffer.
+  std::vector<Buffer> evalLikelihoodBatch(const std::vector<const Parameter*>& parameterList_,
+                                          const std::vector<std::vector<double>>& valueBatch_);
+
   // core
   double evalLikelihood() const;
   double evalStatLikelihood() const;
   double evalPenaltyLikelihood() const;
   [[nodiscard]] double evalStatLikelihood(const Sample& sample_) const;
   [[nodiscard]] double evalPenaltyLikelihood(const ParameterSet& parSet_) const;
+
+  /// Likelihood of a PropagatorWorker. Doesn't touch the internal buffer, so
+  /// workers can be evaluated concurrently.
+  [[nodiscard]] double evalLikelihood(const PropagatorWorker& worker_) const;
+  [[nodiscard]] Buffer evalLikelihoodBuffer(const PropagatorWorker& worker_) const;
   [[nodiscard]] std::string getSummary() const;
 
+  /// Compare the current likelihood with the one obtained with double
+  /// precision dial responses (evaluated on a PropagatorWorker). Returns the
+  /// absolute difference.
+  double checkSinglePrecisionLikelihood();
+
+  /// Check that a PropagatorWorker taken at the current parameter point
+  /// gives the same histograms and LLH as the propagator, bit for bit, and
+  /// that moving the worker leaves the propagator untouched. Throws otherwise.
+  void checkPropagatorWorker();
+
   // dev deprecated
   [[deprecated("use getDataSetManager().getPropagator()")]] [[nodiscard]] const Propagator& getPropagator() const { return _dataSetManager_.getPropagator(); }
   [[deprecated("use getDataSetManager().getPropagator()")]] Propagator& getPropagator(){ return _dataSetManager_.getPropagator(); }
@@ -86,6 +110,9 @@ private:
   std::shared_ptr<JointProbability::JointProbabilityBase> _jointProbabilityPtr_{nullptr};
 
   mutable Buffer _buffer_{};
+
+  /// Lightweight propagator used by the batched evaluations
+  std::unique_ptr<PropagatorWorker> _batchWorker_{nullptr};
 };
 
 #endif //  GUNDAM_LIKELIHOOD_INTERFACE_H
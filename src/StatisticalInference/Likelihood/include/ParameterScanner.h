@@ -34,11 +34,13 @@ public:
   // setters
   void setNbPoints(int nbPoints_){ _nbPoints_ = nbPoints_; }
   void setNbPointsLineScan(int nbPointsLineScan_){ _nbPointsLineScan_ = nbPointsLineScan_; }
+  void setUseBatchEvaluation(bool useBatchEvaluation_){ _useBatchEvaluation_ = useBatchEvaluation_; }
   void setLikelihoodInterfacePtr(LikelihoodInterface* likelihoodInterfacePtr_){ _likelihoodInterfacePtr_ = likelihoodInterfacePtr_; }
 
   // const getters
   [[nodiscard]] bool isUseParameterLimits() const{ return _useParameterLimits_; }
   [[nodiscard]] int getNbPoints() const{ return _nbPoints_; }
+  [[nodiscard]] bool isUseBatchEvaluation() const{ return _useBatchEvaluation_; }
   [[nodiscard]] const std::pair<double, double> &getParameterSigmaRange() const{ return _parameterSigmaRange_; }
   [[nodiscard]] const JsonType &getVarsConfig() const { return _varsConfig_; };
   [[nodiscard]] const std::vector<GraphEntry> &getGraphEntriesBuf() const { return _graphEntriesBuf_; };
@@ -61,6 +63,7 @@ public:
     std::string yTitle{};
     std::vector<double> yPoints{};
     std::function<double()> evalY{};
+    std::function<double(const LikelihoodInterface::Buffer&)> evalBatchY{}; // only set for the LLH components
   };
 
   struct GraphEntry{
@@ -74,6 +77,8 @@ private:
   bool _useParameterLimits_{true};
   int _nbPoints_{100};
   int _nbPointsLineScan_{_nbPoints_};
+  bool _useBatchEvaluation_{true};
+  int _batchEvaluationSize_{8};
   std::pair<double, double> _parameterSigmaRange_{-3,3};
   JsonType _varsConfig_{};
 
@@ -10,6 +10,8 @@
 #include "GenericToolbox.Json.h"
 #include "Logger.h"
 
+#include <cmath>
+
 
 LoggerInit([]{
   Logger::setUserHeaderStr("[LikelihoodInterface]");
@@ -82,6 +84,13 @@ void LikelihoodInterface::initializeImpl() {
   this->propagateAndEvalLikelihood();
   LogInfo << this->getSummary() << std::endl;
 
+  if( _dataSetManager_.getPropagator().getEventDialCache().isUseSinglePrecision() ){
+    this->checkSinglePrecisionLikelihood();
+  }
+  if( _dataSetManager_.getPropagator().isDevCheckPropagatorWorker() ){
+    this->checkPropagatorWorker();
+  }
+
   /// move the parameter away from the prior if needed
   if( not _dataSetManager_.getPropagator().getParameterInjectorMc().empty() ){
     LogWarning << "Injecting parameters on MC samples..." << std::endl;
@@ -106,6 +115,25 @@ void LikelihoodInterface::propagateAndEvalLikelihood(){
   this->evalLikelihood();
 }
 
+std::vector<LikelihoodInterface::Buffer> LikelihoodInterface::evalLikelihoodBatch(
+    const std::vector<const Parameter*>& parameterList_,
+    const std::vector<std::vector<double>>& valueBatch_){
+
+  auto& propagator = _dataSetManager_.getPropagator();
+  if( _batchWorker_ == nullptr or not _batchWorker_->isSynchronizedWithOwner() ){
+    _batchWorker_ = std::make_unique<PropagatorWorker>( propagator );
+  }
+
+  // start from the current state of the propagator
+  _batchWorker_->copyParameterValuesFromOwner();
+  _batchWorker_->copyDataHistogramsFromOwner();
+
+  std::vector<Buffer> out(valueBatch_.size());
+  _batchWorker_->propagateParameterBatch(parameterList_, valueBatch_, [&](size_t iPoint_){
+    out[iPoint_] = this->evalLikelihoodBuffer( *_batchWorker_ );
+  });
+  return out;
+}
 double LikelihoodInterface::evalLikelihood() const {
   this->evalStatLikelihood();
   this->evalPenaltyLikelihood();
@@ -155,6 +183,118 @@ double LikelihoodInterface::evalPenaltyLikelihood(const ParameterSet& parSet_) c
 
   return buffer;
 }
+double LikelihoodInterface::evalLikelihood(const PropagatorWorker& worker_) const {
+  return this->evalLikelihoodBuffer( worker_ ).totalLikelihood;
+}
+LikelihoodInterface::Buffer LikelihoodInterface::evalLikelihoodBuffer(const PropagatorWorker& worker_) const {
+  // same summation order as evalLikelihood()
+  Buffer out{};
+  for( auto& sample : worker_.getSampleList() ){
+    if( not sample.isEnabled() ){ continue; }
+    out.statLikelihood += this->evalStatLikelihood( sample );
+  }
+  for( auto& parSet : worker_.getParameterSetList() ){
+    out.penaltyLikelihood += this->evalPenaltyLikelihood( parSet );
+  }
+  out.updateTotal();
+  return out;
+}
+double LikelihoodInterface::checkSinglePrecisionLikelihood(){
+  LogScopeIndent;
+  auto& propagator = _dataSetManager_.getPropagator();
+
+  // same definition as the worker likelihood: enabled samples only
+  propagator.propagateParameters();
+  double llhSingle{0};
+  for( auto& sample : propagator.getSampleSet().getSampleList() ){
+    if( not sample.isEnabled() ){ continue; }
+    llhSingle += this->evalStatLikelihood( sample );
+  }
+  llhSingle += this->evalPenaltyLikelihood();
+
+  // the worker keeps its dial responses and histograms in double precision
+  PropagatorWorker worker(propagator);
+  worker.copyParameterValuesFromOwner();
+  worker.copyDataHistogramsFromOwner();
+  worker.propagateParameters();
+  double llhDouble{this->evalLikelihood( worker )};
+
+  double diff{std::abs(llhSingle - llhDouble)};
+  LogInfo << "Single precision check: LLH(float) = " << llhSingle << ", LLH(double) = " << llhDouble
+          << ", |diff| = " << diff << " (tolerance: " << propagator.getSinglePrecisionLlhTolerance() << ")" << std::endl;
+  LogAlertIf( diff > propagator.getSinglePrecisionLlhTolerance() )
+    << "The single precision LLH is outside of the tolerance. Consider disabling useSinglePrecisionCache." << std::endl;
+
+  this->evalLikelihood(); // restore the buffer
+  return diff;
+}
+void LikelihoodInterface::checkPropagatorWorker(){
+  LogScopeIndent;
+  auto& propagator = _dataSetManager_.getPropagator();
+  LogInfo << "Checking a PropagatorWorker against the propagator..." << std::endl;
+
+  // same definition as the worker likelihood: enabled samples only
+  propagator.propagateParameters();
+  double llhOwner{0};
+  for( auto& sample : propagator.getSampleSet().getSampleList() ){
+    if( not sample.isEnabled() ){ continue; }
+    llhOwner += this->evalStatLikelihood( sample );
+  }
+  llhOwner += this->evalPenaltyLikelihood();
+
+  // everything the worker is not supposed to write
+  auto fetchOwnerState = [&](){
+    std::vector<double> out{};
+    for( auto& parSet : propagator.getParametersManager().getParameterSetsList() ){
+      for( auto& par : parSet.getParameterList() ){ out.emplace_back( par.getParameterValue() ); }
+      for( auto& par : parSet.getEigenParameterList() ){ out.emplace_back( par.getParameterValue() ); }
+    }
+    for( auto& sample : propagator.getSampleSet().getSampleList() ){
+      for( auto& bin : sample.getMcContainer().getHistogram().binList ){
+        out.emplace_back( bin.content );
+        out.emplace_back( bin.sumW2 );
+      }
+      for( auto& event : sample.getMcContainer().getEventList() ){ out.emplace_back( event.getWeights().current ); }
+    }
+    return out;
+  };
+  auto ownerState = fetchOwnerState();
+
+  PropagatorWorker worker(propagator);
+  worker.copyParameterValuesFromOwner();
+  worker.copyDataHistogramsFromOwner();
+  worker.propagateParameters();
+
+  for( size_t iSample = 0 ; iSample < worker.getSampleList().size() ; iSample++ ){
+    auto& ownerBinList = propagator.getSampleSet().getSampleList()[iSample].getMcContainer().getHistogram().binList;
+    auto& workerBinList = worker.getSampleList()[iSample].getMcContainer().getHistogram().binList;
+    for( size_t iBin = 0 ; iBin < ownerBinList.size() ; iBin++ ){
+      LogThrowIf( workerBinList[iBin].content != ownerBinList[iBin].content or workerBinList[iBin].sumW2 != ownerBinList[iBin].sumW2,
+                  "Worker bin #" << iBin << " of " << worker.getSampleList()[iSample].getName() << " differs from the propagator: "
+                  << workerBinList[iBin].content << " (sumW2=" << workerBinList[iBin].sumW2 << ") != "
+                  << ownerBinList[iBin].content << " (sumW2=" << ownerBinList[iBin].sumW2 << ")" );
+    }
+  }
+  double llhWorker{this->evalLikelihood( worker )};
+  LogThrowIf( llhWorker != llhOwner, "Worker LLH differs from the propagator: " << llhWorker << " != " << llhOwner );
+  LogInfo << "Same histograms and LLH at the propagator point: " << llhWorker << std::endl;
+
+  // move every free parameter of the worker by one sigma
+  for( auto& parSet : worker.getParameterSetList() ){
+    if( not parSet.isEnabled() ){ continue; }
+    for( auto& par : parSet.getEffectiveParameterList() ){
+      if( not par.isEnabled() or par.isFixed() ){ continue; }
+      par.setParameterValue( par.getParameterValue() + par.getStdDevValue() );
+    }
+  }
+  worker.propagateParameters();
+  llhWorker = this->evalLikelihood( worker );
+  LogThrowIf( llhWorker == llhOwner, "Moving the worker parameters did not change its LLH: " << llhWorker );
+  LogThrowIf( fetchOwnerState() != ownerState, "The propagator has been modified by its worker." );
+  LogInfo << "Propagator untouched by the worker (LLH of the moved worker: " << llhWorker << ")" << std::endl;
+
+  this->evalLikelihood(); // restore the buffer
+}
 [[nodiscard]] std::string LikelihoodInterface::getSummary() const {
   std::stringstream ss;
 
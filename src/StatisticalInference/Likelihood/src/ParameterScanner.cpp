@@ -14,6 +14,7 @@
 #include <TDirectory.h>
 
 #include <utility>
+#include <algorithm>
 
 
 LoggerInit([]{
@@ -31,6 +32,9 @@ void ParameterScanner::readConfigImpl() {
   _nbPoints_ = GenericToolbox::Json::fetchValue(_config_, "nbPoints", _nbPoints_);
   _nbPointsLineScan_ = GenericToolbox::Json::fetchValue(_config_, "nbPointsLineScan", _nbPoints_);
   _parameterSigmaRange_ = GenericToolbox::Json::fetchValue(_config_, "parameterSigmaRange", _parameterSigmaRange_);
+  _useBatchEvaluation_ = GenericToolbox::Json::fetchValue(_config_, "useBatchEvaluation", _useBatchEvaluation_);
+  _batchEvaluationSize_ = GenericToolbox::Json::fetchValue(_config_, "batchEvaluationSize", _batchEvaluationSize_);
+  LogThrowIf( _batchEvaluationSize_ < 1, "Invalid batchEvaluationSize: " << _batchEvaluationSize_ );
 
   _varsConfig_ = GenericToolbox::Json::fetchValue(_config_, "varsConfig", JsonType());
 
@@ -50,6 +54,7 @@ void ParameterScanner::initializeImpl() {
     scanEntry.title = "Total Likelihood Scan";
     scanEntry.yTitle = "LLH value";
     scanEntry.evalY = [this](){ return _likelihoodInterfacePtr_->getLastLikelihood(); };
+    scanEntry.evalBatchY = [](const LikelihoodInterface::Buffer& buffer_){ return buffer_.totalLikelihood; };
   }
   if( GenericToolbox::Json::fetchValue(_varsConfig_, "llhPenalty", true) ){
     _scanDataDict_.emplace_back();
@@ -60,6 +65,7 @@ void ParameterScanner::initializeImpl() {
     scanEntry.title = "Penalty Likelihood Scan";
     scanEntry.yTitle = "Penalty LLH value";
     scanEntry.evalY = [this](){ return _likelihoodInterfacePtr_->getLastPenaltyLikelihood(); };
+    scanEntry.evalBatchY = [](const LikelihoodInterface::Buffer& buffer_){ return buffer_.penaltyLikelihood; };
   }
   if( GenericToolbox::Json::fetchValue(_varsConfig_, "llhStat", true) ){
     _scanDataDict_.emplace_back();
@@ -69,6 +75,7 @@ void ParameterScanner::initializeImpl() {
     scanEntry.title = "Stat Likelihood Scan";
     scanEntry.yTitle = "Stat LLH value";
     scanEntry.evalY = [this](){ return _likelihoodInterfacePtr_->getLastStatLikelihood(); };
+    scanEntry.evalBatchY = [](const LikelihoodInterface::Buffer& buffer_){ return buffer_.statLikelihood; };
   }
   if( GenericToolbox::Json::fetchValue(_varsConfig_, "llhStatPerSample", false) ){
     _scanDataDict_.reserve( _likelihoodInterfacePtr_->getDataSetManager().getPropagator().getSampleSet().getSampleList().size() );
@@ -159,6 +166,7 @@ void ParameterScanner::scanParameter(Parameter& par_, TDirectory* saveDir_) {
     highBound = std::min(highBound, par_.getMaxValue());
   }
 
+  std::vector<double> scanValueList(_nbPoints_+1,0);
   int offSet{0}; // offset help make sure the first point
   for( int iPt = 0 ; iPt < _nbPoints_+1 ; iPt++ ){
     double newVal = lowBound + double(iPt-offSet)/(_nbPoints_-1)*( highBound - lowBound );
@@ -182,12 +190,41 @@ void ParameterScanner::scanParameter(Parameter& par_, TDirectory* saveDir_) {
         << GET_VAR_NAME_VALUE(par_.getStdDevValue()) << std::endl
         );
 
-    par_.setParameterValue(newVal);
+    scanValueList[iPt] = newVal;
+  }
 
-    _likelihoodInterfacePtr_->propagateAndEvalLikelihood();
-    parPoints[iPt] = par_.getParameterValue();
+  // the batched evaluation only provides the LLH components
+  bool useBatchEvaluation{_useBatchEvaluation_ and std::all_of(
+      _scanDataDict_.begin(), _scanDataDict_.end(),
+      [](const ScanData& scanData_){ return bool(scanData_.evalBatchY); }
+  )};
+
+  if( useBatchEvaluation ){
+    // a single pass over the events per batch of points: the propagator doesn't move
+    const std::vector<const Parameter*> parList{&par_};
+    for( size_t iBegin = 0 ; iBegin < scanValueList.size() ; iBegin += size_t(_batchEvaluationSize_) ){
+      size_t iEnd{std::min( iBegin + size_t(_batchEvaluationSize_), scanValueList.size() )};
+
+      std::vector<std::vector<double>> valueBatch{};
+      valueBatch.reserve( iEnd - iBegin );
+      for( size_t iPt = iBegin ; iPt < iEnd ; iPt++ ){ valueBatch.emplace_back( 1, scanValueList[iPt] ); }
+
+      auto bufferList = _likelihoodInterfacePtr_->evalLikelihoodBatch( parList, valueBatch );
+      for( size_t iPt = iBegin ; iPt < iEnd ; iPt++ ){
+        parPoints[iPt] = scanValueList[iPt];
+        for( auto& scanEntry : _scanDataDict_ ){ scanEntry.yPoints[iPt] = scanEntry.evalBatchY( bufferList[iPt - iBegin] ); }
+      }
+    }
+  }
+  else{
+    for( int iPt = 0 ; iPt < _nbPoints_+1 ; iPt++ ){
+      par_.setParameterValue(scanValueList[iPt]);
 
-    for( auto& scanEntry : _scanDataDict_ ){ scanEntry.yPoints[iPt] = scanEntry.evalY(); }
+      _likelihoodInterfacePtr_->propagateAndEvalLikelihood();
+      parPoints[iPt] = par_.getParameterValue();
+
+      for( auto& scanEntry : _scanDataDict_ ){ scanEntry.yPoints[iPt] = scanEntry.evalY(); }
+    }
   }
 
   // sorting points in increasing order
@@ -201,8 +238,10 @@ void ParameterScanner::scanParameter(Parameter& par_, TDirectory* saveDir_) {
   }
 
 
-  par_.setParameterValue(origVal);
-  _likelihoodInterfacePtr_->propagateAndEvalLikelihood();
+  if( not useBatchEvaluation ){
+    par_.setParameterValue(origVal);
+    _likelihoodInterfacePtr_->propagateAndEvalLikelihood();
+  }
 
   // Disable the auto conversion from Eigen to Original if the fit is set to use eigen decomp
   if( par_.getOwner()->isEnableEigenDecomp() and not par_.isEigen() ){
@@ -45,10 +45,14 @@ namespace {
     // CalculateCompactSpline, and CalculateMonotonicSpline have very similar,
     // but different calls.  In particular the dim parameter meaning is not
     // consistent.
+    //
+    // The knot data can be stored in single precision (DataType=float): the
+    // calculation is always done in double precision.
+    template<typename DataType = DEVICE_FLOATING_POINT>
     DEVICE_CALLABLE_INLINE
     double CalculateCompactSpline(const double x,
                                   const double lowerBound, double upperBound,
-                                  const DEVICE_FLOATING_POINT* data,
+                                  const DataType* data,
                                   const int dim) {
 
         // Interpolate between p2 and p3
@@ -46,10 +46,14 @@ namespace {
     // CalculateCompactSpline, and CalculateMonotonicSpline have very similar,
     // but different calls.  In particular the dim parameter meaning is not
     // consistent.
+    //
+    // The knot data can be stored in single precision (DataType=float): the
+    // calculation is always done in double precision.
+    template<typename DataType = DEVICE_FLOATING_POINT>
     DEVICE_CALLABLE_INLINE
     double CalculateGeneralSpline(const double x,
                                   const double lowerBound, double upperBound,
-                                  const DEVICE_FLOATING_POINT* data,
+                                  const DataType* data,
                                   const int dim) {
 
 #if defined(CALCULATE_GENERAL_SPLINE_LINEAR_IF)
@@ -131,6 +135,7 @@ namespace {
         CHECK_OFFSET(4);
         CHECK_OFFSET(2);
         CHECK_OFFSET(1);
+#undef CHECK_OFFSET
 #endif
         const double x1 = data[2+3*ix+2];
         const double x2 = data[2+3*(ix+1)+2];
@@ -59,6 +59,7 @@ namespace {
         CHECK_OFFSET(4);
         CHECK_OFFSET(2);
         CHECK_OFFSET(1);
+#undef CHECK_OFFSET
 
         const double p1 = data[2*ix];
         const double x1 = data[2*ix+1];
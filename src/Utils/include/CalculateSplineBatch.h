@@ -0,0 +1,66 @@
+#ifndef GUNDAM_CALCULATE_SPLINE_BATCH_H
+#define GUNDAM_CALCULATE_SPLINE_BATCH_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+
+/// Batched versions of CalculateCompactSpline, CalculateMonotonicSpline,
+/// CalculateUniformSpline and CalculateGeneralSpline: all the splines of a
+/// group are evaluated at the same input value in one call. The knots are
+/// stored as structure-of-arrays (knot-major) such that consecutive splines
+/// are processed in SIMD lanes. The kernels are compiled for AVX-512, AVX2
+/// and the baseline instruction set, and the version matching the CPU is
+/// picked at run time (x86_64 linux with GCC/Clang, baseline elsewhere).
+///
+/// The results are identical to the scalar functions.
+namespace SplineBatch {
+
+  enum class Type{ Compact, Monotonic, Uniform, General };
+
+  /// Splines of the same type and the same number of knots
+  struct Group{
+    Type type{Type::Compact};
+    int nKnots{0};
+    size_t nSplines{0};
+
+    // per spline: input clamping (+/-inf if extrapolation is allowed)
+    std::vector<double> xMinList{};
+    std::vector<double> xMaxList{};
+    // per spline: first knot and step (uniform knots only)
+    std::vector<double> lowList{};
+    std::vector<double> stepList{};
+    // per knot and per spline: [iKnot*nSplines + iSpline]
+    std::vector<double> valueList{};
+    std::vector<double> slopeList{}; // Uniform and General
+    std::vector<double> knotList{};  // General
+    // General only: interval used by the last evaluation. Small steps of the
+    // input usually stay in the same interval and skip the knot search.
+    std::vector<int> lastIntervalList{};
+
+    /// Add a spline defined by the data block of the scalar function
+    /// (DialBase::getDialData()). Splines can't be added once evaluated.
+    void addSpline(const std::vector<double>& splineData_, double xMin_, double xMax_);
+    /// Transpose the spline data into the SoA layout
+    void finalize();
+
+  private:
+    std::vector<std::vector<double>> _pendingDataList_{};
+  };
+
+  /// Number of knots of a spline data block
+  int getNbKnots(Type type_, size_t dataSize_);
+
+  /// Evaluate the splines [begin_, end_) of a group at x_. Results are
+  /// written in out_[iSpline]. Threads can evaluate disjoint ranges of the
+  /// same group concurrently.
+  void evalGroup(Group& group_, double x_, double* out_, size_t begin_, size_t end_);
+
+  /// Instruction set picked by the run-time dispatch
+  std::string getSimdLevel();
+
+}
+
+
+#endif //GUNDAM_CALCULATE_SPLINE_BATCH_H
@@ -43,10 +43,14 @@ namespace {
     // CalculateCompactSpline, and CalculateMonotonicSpline have very similar,
     // but different calls.  In particular the dim parameter meaning is not
     // consistent.
+    //
+    // The knot data can be stored in single precision (DataType=float): the
+    // calculation is always done in double precision.
+    template<typename DataType = DEVICE_FLOATING_POINT>
     DEVICE_CALLABLE_INLINE
     double CalculateUniformSpline(const double x,
                                   const double lowerBound, double upperBound,
-                                  const DEVICE_FLOATING_POINT* data,
+                                  const DataType* data,
                                   const int dim) {
 
         // Get the integer part
@@ -0,0 +1,26 @@
+#ifndef GUNDAM_GUNDAM_COMPENSATED_SUM_H
+#define GUNDAM_GUNDAM_COMPENSATED_SUM_H
+
+
+namespace GundamUtils {
+
+  /// Kahan-Babuska (Neumaier) summation: the rounding error of each addition
+  /// is kept aside and added back at the end. The error of the sum no longer
+  /// grows with the number of terms. Won't work if compiled with -ffast-math.
+  struct CompensatedSum{
+    double sum{0};
+    double compensation{0};
+
+    void add(double value_){
+      double temp{sum + value_};
+      if( (sum >= 0 ? sum : -sum) >= (value_ >= 0 ? value_ : -value_) ){ compensation += (sum - temp) + value_; }
+      else{ compensation += (value_ - temp) + sum; }
+      sum = temp;
+    }
+    [[nodiscard]] double get() const { return sum + compensation; }
+  };
+
+}
+
+
+#endif //GUNDAM_GUNDAM_COMPENSATED_SUM_H
@@ -0,0 +1,85 @@
+#ifndef GUNDAM_GUNDAM_NUMA_H
+#define GUNDAM_GUNDAM_NUMA_H
+
+#include <new>
+#include <vector>
+#include <cstdlib>
+#include <utility>
+#include <cstddef>
+
+
+namespace GundamNuma {
+
+  // size of a transparent huge page on x86_64/aarch64 linux
+  static const size_t hugePageSize{size_t(2) << 20};
+
+  /// Number of NUMA nodes seen by the kernel (1 if it can't be determined)
+  int getNbNodes();
+
+  /// List of the CPUs attached to a given node
+  std::vector<int> getNodeCpuList(int node_);
+
+  /// Worker threads are attributed to the nodes by contiguous blocks, such that
+  /// the thread ranges of a node form one slab of the event cache.
+  int getThreadNode(int iThread_, int nThreads_, int nNodes_);
+  std::pair<int, int> getNodeThreadRange(int node_, int nThreads_, int nNodes_); // [begin, end)
+
+  /// Restrict the calling thread to the CPUs of a node. Returns false if not supported.
+  bool pinCurrentThreadToNode(int node_);
+
+  /// Pins the calling thread to a node for the lifetime of the guard, then
+  /// restores its previous affinity. Nothing is done for a negative node.
+  class ThreadAffinityGuard{
+  public:
+    explicit ThreadAffinityGuard(int node_);
+    ~ThreadAffinityGuard();
+
+    ThreadAffinityGuard(const ThreadAffinityGuard&) = delete;
+    ThreadAffinityGuard& operator=(const ThreadAffinityGuard&) = delete;
+
+  private:
+    bool _isPinned_{false};
+    std::vector<unsigned char> _previousAffinity_{}; // opaque cpu_set_t
+  };
+
+  /// Request the memory range to be backed by transparent huge pages (linux only)
+  void adviseHugePages(void* ptr_, size_t size_);
+
+
+  /// Allocator that does not initialize the elements when they are created
+  /// without argument, and gives page aligned blocks. Pages are then only
+  /// physically allocated by the first thread writing into them (first-touch
+  /// policy of the kernel) on the NUMA node of that thread. Large blocks are
+  /// aligned on huge pages and flagged for huge page backing.
+  template<typename T> struct FirstTouchAllocator{
+    typedef T value_type;
+
+    FirstTouchAllocator() = default;
+    template<typename U> FirstTouchAllocator(const FirstTouchAllocator<U>&){}
+
+    T* allocate(size_t n_){
+      size_t size{n_ * sizeof(T)};
+      size_t alignment{size >= hugePageSize ? hugePageSize : size_t(4096)};
+      void* ptr{nullptr};
+      if( posix_memalign(&ptr, alignment, size) != 0 ){ throw std::bad_alloc(); }
+      if( size >= hugePageSize ){ adviseHugePages(ptr, size); }
+      return static_cast<T*>(ptr);
+    }
+    void deallocate(T* ptr_, size_t){ std::free(ptr_); }
+
+    // default-init instead of value-init: the memory is not touched
+    template<typename U> void construct(U* ptr_){ ::new(static_cast<void*>(ptr_)) U; }
+    template<typename U, typename... Args> void construct(U* ptr_, Args&&... args_){
+      ::new(static_cast<void*>(ptr_)) U(std::forward<Args>(args_)...);
+    }
+
+    template<typename U> bool operator==(const FirstTouchAllocator<U>&) const { return true; }
+    template<typename U> bool operator!=(const FirstTouchAllocator<U>&) const { return false; }
+  };
+
+  template<typename T> using FirstTouchVector = std::vector<T, FirstTouchAllocator<T>>;
+
+}
+
+
+#endif //GUNDAM_GUNDAM_NUMA_H
@@ -0,0 +1,279 @@
+#include "CalculateSplineBatch.h"
+
+#include <limits>
+#include <stdexcept>
+
+
+// Function multi-versioning: the compiler generates one version of the
+// kernel per target and an ifunc resolver picking the best one for the CPU
+// at load time.
+#if defined(__x86_64__) && defined(__linux__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define SPLINE_BATCH_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#define SPLINE_BATCH_HAS_DISPATCH
+#endif
+#endif
+#ifndef SPLINE_BATCH_DISPATCH
+#define SPLINE_BATCH_DISPATCH
+#endif
+
+// No fused multiply-add contraction in the AVX2/AVX-512 versions: the
+// results must stay bitwise identical to the scalar functions.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("fp-contract=off")
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+
+namespace {
+
+  // same bounds as the ones used by the dials with the scalar functions
+  const double lowerBound{-1E20};
+  const double upperBound{1E20};
+
+  inline double clampInput(double x_, double xMin_, double xMax_){
+    if( x_ < xMin_ ){ return xMin_; }
+    if( x_ > xMax_ ){ return xMax_; }
+    return x_;
+  }
+  inline int clampIndex(int index_, int max_){
+    if( index_ < 0 ){ index_ = 0; }
+    if( index_ > max_ ){ index_ = max_; }
+    return index_;
+  }
+  inline double clampOutput(double v_){
+    if( v_ < lowerBound ){ v_ = lowerBound; }
+    if( v_ > upperBound ){ v_ = upperBound; }
+    return v_;
+  }
+  inline double hermite(double p1_, double p2_, double m1_, double m2_, double fx_){
+    return ((((2.0*p1_ - 2.0*p2_ + m2_ + m1_)*fx_
+              + 3.0*p2_ - 3.0*p1_ - m2_ - 2.0*m1_)*fx_
+             +m1_)*fx_
+            +p1_);
+  }
+
+  // see CalculateCompactSpline() and CalculateMonotonicSpline()
+  template<bool isMonotonic> SPLINE_BATCH_DISPATCH
+  void evalCatmullRom(const SplineBatch::Group& g_, double x_, double* out_, size_t begin_, size_t end_){
+    const size_t n{g_.nSplines};
+    const int dim{g_.nKnots};
+    const double* y{g_.valueList.data()};
+
+    for( size_t i = begin_ ; i < end_ ; i++ ){
+      const double x{clampInput(x_, g_.xMinList[i], g_.xMaxList[i])};
+      const double xx{(x - g_.lowList[i]) / g_.stepList[i]};
+      const int ix = (xx < 0) ? int(xx - 1) : int(xx);
+
+      const int d21_0{clampIndex(ix - 1, dim - 2)};
+      const int d32_0{clampIndex(ix, dim - 2)};
+      const int d43_0{clampIndex(ix + 1, dim - 2)};
+
+      const double p2{y[size_t(d32_0)*n + i]};
+      const double p3{y[size_t(d32_0 + 1)*n + i]};
+      const double fx{xx - d32_0};
+
+      const double d21{y[size_t(d21_0 + 1)*n + i] - y[size_t(d21_0)*n + i]};
+      const double d32{p3 - p2};
+      const double d43{y[size_t(d43_0 + 1)*n + i] - y[size_t(d43_0)*n + i]};
+
+      double m2{0.5*(d21 + d32)};
+      double m3{0.5*(d32 + d43)};
+
+      if( isMonotonic ){
+        // Fritsch-Carlson condition
+        if( d32*d21 <= 0.0 ){ m2 = 0.0; }
+        if( d43*d32 <= 0.0 ){ m3 = 0.0; }
+
+        const double ad21{(d21 < 0) ? -d21 : d21};
+        const double ad32{(d32 < 0) ? -d32 : d32};
+        const double ad43{(d43 < 0) ? -d43 : d43};
+
+        const double delta2{3.0*((ad21 < ad32) ? ad21 : ad32)};
+        const double delta3{3.0*((ad32 < ad43) ? ad32 : ad43)};
+
+        if( m2 > delta2 ){ m2 = delta2; }
+        if( m2 < -delta2 ){ m2 = -delta2; }
+        if( m3 > delta3 ){ m3 = delta3; }
+        if( m3 < -delta3 ){ m3 = -delta3; }
+      }
+
+      out_[i] = clampOutput(hermite(p2, p3, m2, m3, fx));
+    }
+  }
+
+  // see CalculateUniformSpline()
+  SPLINE_BATCH_DISPATCH
+  void evalUniform(const SplineBatch::Group& g_, double x_, double* out_, size_t begin_, size_t end_){
+    const size_t n{g_.nSplines};
+    const int dim{2 + 2*g_.nKnots};
+    const double* y{g_.valueList.data()};
+    const double* m{g_.slopeList.data()};
+
+    for( size_t i = begin_ ; i < end_ ; i++ ){
+      const double x{clampInput(x_, g_.xMinList[i], g_.xMaxList[i])};
+      const double step{g_.stepList[i]};
+      const double xx{(x - g_.lowList[i]) / step};
+      int ix = int(xx);
+      if( ix < 0 ){ ix = 0; }
+      if( 2*ix + 7 > dim ){ ix = (dim - 2)/2 - 2; }
+
+      const double fx{xx - ix};
+      const double p1{y[size_t(ix)*n + i]};
+      const double m1{m[size_t(ix)*n + i]*step};
+      const double p2{y[size_t(ix + 1)*n + i]};
+      const double m2{m[size_t(ix + 1)*n + i]*step};
+
+      out_[i] = clampOutput(hermite(p1, p2, m1, m2, fx));
+    }
+  }
+
+  // see CalculateGeneralSpline(). The knot search is done beforehand, so the
+  // evaluation loop has no data dependent branch.
+  SPLINE_BATCH_DISPATCH
+  void evalGeneral(const SplineBatch::Group& g_, double x_, double* out_, size_t begin_, size_t end_){
+    const size_t n{g_.nSplines};
+    const double* y{g_.valueList.data()};
+    const double* m{g_.slopeList.data()};
+    const double* xk{g_.knotList.data()};
+    const int* interval{g_.lastIntervalList.data()};
+
+    for( size_t i = begin_ ; i < end_ ; i++ ){
+      const double x{clampInput(x_, g_.xMinList[i], g_.xMaxList[i])};
+      const int ix{interval[i]};
+      const double x1{xk[size_t(ix)*n + i]};
+      const double x2{xk[size_t(ix + 1)*n + i]};
+      const double step{x2 - x1};
+      const double fx{(x - x1)/step};
+
+      const double p1{y[size_t(ix)*n + i]};
+      const double m1{m[size_t(ix)*n + i]*step};
+      const double p2{y[size_t(ix + 1)*n + i]};
+      const double m2{m[size_t(ix + 1)*n + i]*step};
+
+      out_[i] = clampOutput(hermite(p1, p2, m1, m2, fx));
+    }
+  }
+
+  // same result as the binary search of CalculateGeneralSpline(): the
+  // interval is the last one with x > knot, among the first
+  // min(nKnots-2, 16) intervals.
+  void updateGeneralIntervals(SplineBatch::Group& g_, double x_, size_t begin_, size_t end_){
+    const size_t n{g_.nSplines};
+    const int knotCount{g_.nKnots - 2};
+    const double* xk{g_.knotList.data()};
+
+    for( size_t i = begin_ ; i < end_ ; i++ ){
+      const double x{clampInput(x_, g_.xMinList[i], g_.xMaxList[i])};
+      int& ix = g_.lastIntervalList[i];
+
+      // cached interval still valid?
+      bool isLowValid{ix == 0 or x > xk[size_t(ix)*n + i]};
+      bool isHighValid{ix + 1 >= knotCount or ix == 15 or not (x > xk[size_t(ix + 1)*n + i])};
+      if( isLowValid and isHighValid ){ continue; }
+
+      ix = 0;
+      for( int offset : {8, 4, 2, 1} ){
+        if( ix + offset < knotCount and x > xk[size_t(ix + offset)*n + i] ){ ix += offset; }
+      }
+    }
+  }
+
+}
+
+
+namespace SplineBatch {
+
+  int getNbKnots(Type type_, size_t dataSize_){
+    switch( type_ ){
+      case Type::Compact:
+      case Type::Monotonic: return int(dataSize_) - 2;
+      case Type::Uniform: return (int(dataSize_) - 2)/2;
+      case Type::General: return (int(dataSize_) - 2)/3;
+    }
+    return 0;
+  }
+
+  void Group::addSpline(const std::vector<double>& splineData_, double xMin_, double xMax_){
+    if( getNbKnots(type, splineData_.size()) != nKnots ){
+      throw std::runtime_error("SplineBatch: spline with an unexpected number of knots.");
+    }
+    if( nSplines != 0 ){
+      throw std::runtime_error("SplineBatch: can't add a spline to a finalized group.");
+    }
+    _pendingDataList_.emplace_back( splineData_ );
+    xMinList.emplace_back( xMin_ );
+    xMaxList.emplace_back( xMax_ );
+  }
+
+  void Group::finalize(){
+    nSplines = _pendingDataList_.size();
+    lowList.resize(nSplines);
+    stepList.resize(nSplines);
+    valueList.resize(size_t(nKnots) * nSplines);
+    if( type == Type::Uniform or type == Type::General ){ slopeList.resize(size_t(nKnots) * nSplines); }
+    if( type == Type::General ){
+      knotList.resize(size_t(nKnots) * nSplines);
+      lastIntervalList.resize(nSplines, 0);
+    }
+
+    for( size_t iSpline = 0 ; iSpline < nSplines ; iSpline++ ){
+      auto& data = _pendingDataList_[iSpline];
+      lowList[iSpline] = data[0];
+      stepList[iSpline] = data[1];
+      for( int iKnot = 0 ; iKnot < nKnots ; iKnot++ ){
+        size_t iSoa{size_t(iKnot)*nSplines + iSpline};
+        switch( type ){
+          case Type::Compact:
+          case Type::Monotonic:
+            valueList[iSoa] = data[2 + iKnot];
+            break;
+          case Type::Uniform:
+            valueList[iSoa] = data[2 + 2*iKnot];
+            slopeList[iSoa] = data[2 + 2*iKnot + 1];
+            break;
+          case Type::General:
+            valueList[iSoa] = data[2 + 3*iKnot];
+            slopeList[iSoa] = data[2 + 3*iKnot + 1];
+            knotList[iSoa] = data[2 + 3*iKnot + 2];
+            break;
+        }
+      }
+    }
+
+    _pendingDataList_.clear();
+    _pendingDataList_.shrink_to_fit();
+  }
+
+  void evalGroup(Group& group_, double x_, double* out_, size_t begin_, size_t end_){
+    if( end_ > group_.nSplines ){ end_ = group_.nSplines; }
+    if( begin_ >= end_ ){ return; }
+
+    switch( group_.type ){
+      case Type::Compact:
+        evalCatmullRom<false>(group_, x_, out_, begin_, end_);
+        break;
+      case Type::Monotonic:
+        evalCatmullRom<true>(group_, x_, out_, begin_, end_);
+        break;
+      case Type::Uniform:
+        evalUniform(group_, x_, out_, begin_, end_);
+        break;
+      case Type::General:
+        updateGeneralIntervals(group_, x_, begin_, end_);
+        evalGeneral(group_, x_, out_, begin_, end_);
+        break;
+    }
+  }
+
+  std::string getSimdLevel(){
+#ifdef SPLINE_BATCH_HAS_DISPATCH
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx512f") ){ return "avx512f"; }
+    if( __builtin_cpu_supports("avx2") ){ return "avx2"; }
+#endif
+    return "scalar";
+  }
+
+}
@@ -0,0 +1,99 @@
+#include "GundamNuma.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+
+namespace GundamNuma {
+
+  int getNbNodes(){
+    int nNodes{0};
+#ifdef __linux__
+    while( std::ifstream("/sys/devices/system/node/node" + std::to_string(nNodes) + "/cpulist").good() ){ nNodes++; }
+#endif
+    return std::max(nNodes, 1);
+  }
+
+  std::vector<int> getNodeCpuList(int node_){
+    std::vector<int> out;
+#ifdef __linux__
+    // format is "0-15,32-47"
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node_) + "/cpulist");
+    std::string line;
+    if( not std::getline(file, line) ){ return out; }
+
+    std::stringstream ss(line);
+    std::string range;
+    while( std::getline(ss, range, ',') ){
+      if( range.empty() ){ continue; }
+      auto dashPos = range.find('-');
+      int first{std::stoi(range.substr(0, dashPos))};
+      int last{dashPos == std::string::npos ? first : std::stoi(range.substr(dashPos + 1))};
+      for( int iCpu = first ; iCpu <= last ; iCpu++ ){ out.emplace_back(iCpu); }
+    }
+#endif
+    return out;
+  }
+
+  int getThreadNode(int iThread_, int nThreads_, int nNodes_){
+    if( nThreads_ <= 0 or nNodes_ <= 1 ){ return 0; }
+    return int( (long(iThread_) * nNodes_) / nThreads_ );
+  }
+  std::pair<int, int> getNodeThreadRange(int node_, int nThreads_, int nNodes_){
+    if( nNodes_ <= 1 ){ return {0, nThreads_}; }
+    // inverse of getThreadNode(): first threads t such that t*nNodes >= node*nThreads
+    auto firstThread = [&](int node){ return int( (long(node) * nThreads_ + nNodes_ - 1) / nNodes_ ); };
+    return { firstThread(node_), firstThread(node_ + 1) };
+  }
+
+  bool pinCurrentThreadToNode(int node_){
+#ifdef __linux__
+    auto cpuList = getNodeCpuList(node_);
+    if( cpuList.empty() ){ return false; }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for( auto& iCpu : cpuList ){ CPU_SET(iCpu, &cpuSet); }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+    (void) node_;
+    return false;
+#endif
+  }
+
+  ThreadAffinityGuard::ThreadAffinityGuard(int node_){
+#ifdef __linux__
+    if( node_ < 0 ){ return; }
+    _previousAffinity_.resize( sizeof(cpu_set_t) );
+    auto* previousSet = reinterpret_cast<cpu_set_t*>( _previousAffinity_.data() );
+    if( pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), previousSet) != 0 ){ return; }
+    _isPinned_ = pinCurrentThreadToNode( node_ );
+#else
+    (void) node_;
+#endif
+  }
+  ThreadAffinityGuard::~ThreadAffinityGuard(){
+#ifdef __linux__
+    if( not _isPinned_ ){ return; }
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), reinterpret_cast<const cpu_set_t*>( _previousAffinity_.data() ));
+#endif
+  }
+
+  void adviseHugePages(void* ptr_, size_t size_){
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // only a hint: ignored if THP are disabled on the system
+    madvise(ptr_, size_, MADV_HUGEPAGE);
+#else
+    (void) ptr_; (void) size_;
+#endif
+  }
+
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "DialBase.h"
+#include "DialInputBuffer.h"
+
+#include "gtest/gtest.h"
+
+// a cheap dial: the concurrent tests are stressing the cache
+class LinearDial : public DialBase {
+public:
+  [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<LinearDial>(*this); }
+  [[nodiscard]] std::string getDialTypeName() const override { return {"LinearDial"}; }
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    return 1 + _slope_ * input_.getInputBuffer()[0];
+  }
+  double _slope_{0.5};
+};
+typedef CachedDial<LinearDial> LinearDialCache;
+
+namespace {
+  // evaluate every dial with every thread. Returns the number of wrong responses.
+  long runPass(const std::vector<LinearDialCache>& dialList_, const std::vector<DialInputBuffer>& inputList_, int nThreads_){
+    std::atomic<long> nErrors{0};
+    std::vector<std::thread> threadList;
+    for( int iThread = 0 ; iThread < nThreads_ ; iThread++ ){
+      threadList.emplace_back([&, iThread]{
+        long nLocalErrors{0};
+        for( size_t iDial = 0 ; iDial < dialList_.size() ; iDial++ ){
+          auto& input = inputList_[(iDial + iThread) % inputList_.size()];
+          double expected{1 + 0.5 * input.getInputBuffer()[0]};
+          if( dialList_[iDial].evalResponse(input) != expected ){ nLocalErrors++; }
+        }
+        nErrors += nLocalErrors;
+      });
+    }
+    for( auto& thread : threadList ){ thread.join(); }
+    return nErrors;
+  }
+}
+
+TEST(cachedDialTest, MemoryFootprint)
+{
+  EXPECT_LE(sizeof(LinearDialCache) - sizeof(LinearDial), 16);
+}
+
+TEST(cachedDialTest, CopyDropsCache)
+{
+  DialInputBuffer input;
+  input.getInputBuffer().resize(1);
+  input.setInputValue(0, 2);
+
+  LinearDialCache dial;
+  EXPECT_EQ(dial.evalResponse(input), 2);
+  EXPECT_TRUE(dial.isCacheValid(input));
+
+  LinearDialCache copy{dial};
+  EXPECT_FALSE(copy.isCacheValid(input));
+
+  // a copy of the buffer takes a new epoch as soon as it is modified
+  DialInputBuffer other{input};
+  other.setInputValue(0, 4);
+  EXPECT_FALSE(dial.isCacheValid(other));
+  EXPECT_EQ(dial.evalResponse(other), 3);
+}
+
+TEST(cachedDialTest, ConcurrentEvaluation)
+{
+  int nThreads{std::max(2, int(std::thread::hardware_concurrency()))};
+  std::vector<LinearDialCache> dialList(4000);
+
+  // several input buffers: concurrent writes with different epochs
+  std::vector<DialInputBuffer> inputList(4);
+  for( auto& input : inputList ){ input.getInputBuffer().resize(1); }
+
+  long nErrors{0};
+  for( int iRound = 0 ; iRound < 5 ; iRound++ ){
+    for( size_t iInput = 0 ; iInput < inputList.size() ; iInput++ ){
+      inputList[iInput].setInputValue(0, 0.1 * iRound + double(iInput));
+    }
+    nErrors += runPass(dialList, inputList, nThreads);
+    // second pass: every response is cached
+    nErrors += runPass(dialList, inputList, nThreads);
+  }
+  EXPECT_EQ(nErrors, 0);
+}
+
+// Benchmark, not run by default: --gtest_also_run_disabled_tests
+TEST(cachedDialTest, DISABLED_ConcurrentThroughput)
+{
+  std::cout << "sizeof(LinearDial) = " << sizeof(LinearDial) << " bytes" << std::endl;
+  std::cout << "sizeof(CachedDial<LinearDial>) = " << sizeof(LinearDialCache) << " bytes" << std::endl;
+  std::cout << "Cache overhead per dial = " << sizeof(LinearDialCache) - sizeof(LinearDial) << " bytes" << std::endl;
+
+  int nThreads{std::max(32, int(std::thread::hardware_concurrency()))};
+  std::vector<LinearDialCache> dialList(200000);
+
+  std::vector<DialInputBuffer> inputList(4);
+  for( auto& input : inputList ){ input.getInputBuffer().resize(1); }
+
+  int nRounds{20};
+  long nErrors{0};
+  double nSeconds{0};
+  for( int iRound = 0 ; iRound < nRounds ; iRound++ ){
+    for( size_t iInput = 0 ; iInput < inputList.size() ; iInput++ ){
+      inputList[iInput].setInputValue(0, 0.1 * iRound + double(iInput));
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    nErrors += runPass(dialList, inputList, nThreads);
+    nErrors += runPass(dialList, inputList, nThreads);
+    nSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+  }
+
+  double nEvals{2. * nRounds * nThreads * double(dialList.size())};
+  std::cout << nThreads << " threads: " << nEvals / nSeconds / 1E6 << " M evals/s" << std::endl;
+  EXPECT_EQ(nErrors, 0);
+}
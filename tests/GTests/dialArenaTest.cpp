@@ -0,0 +1,134 @@
+#include <vector>
+#include <memory>
+#include <random>
+
+#include "DialArena.h"
+#include "DialInputBuffer.h"
+
+#include "testDialFactory.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+  // the points also probe the extrapolation outside of [-3, 3]
+  long countMismatches(const std::vector<DialBase*>& dialList_, const std::vector<std::unique_ptr<DialBase>>& refList_){
+    DialInputBuffer input;
+    input.getInputBuffer().resize(1);
+
+    long nMismatches{0};
+    for( double x = -4 ; x <= 4 ; x += 0.05 ){
+      input.setInputValue(0, x);
+      for( size_t iDial = 0 ; iDial < dialList_.size() ; iDial++ ){
+        if( dialList_[iDial]->evalResponse(input) != refList_[iDial]->evalResponse(input) ){ nMismatches++; }
+      }
+    }
+    return nMismatches;
+  }
+}
+
+TEST(dialArenaTest, ArenaMatchesHeap)
+{
+  std::mt19937 rng(1234);
+
+  for( auto typeTag : testDialFactory::getConcreteTypeTagList() ){
+    SCOPED_TRACE( DialArena::getTypeTagName(typeTag) );
+
+    DialArena arena;
+    std::vector<DialBase*> arenaList{};
+    std::vector<std::unique_ptr<DialBase>> heapList{};
+    for( int iDial = 0 ; iDial < 100 ; iDial++ ){
+      auto dial = testDialFactory::makeDial(typeTag, rng);
+      ASSERT_NE(dial, nullptr);
+      heapList.emplace_back( dial->clone() );
+      arenaList.emplace_back( arena.store(dial) );
+      ASSERT_NE(arenaList.back(), nullptr);
+      EXPECT_EQ(dial, nullptr);
+    }
+
+    // every type has its own pool: nothing is left to the caller
+    EXPECT_EQ(arena.getNbForeignDials(), 0);
+    EXPECT_EQ(arena.getNbDials(typeTag), 100);
+    EXPECT_EQ(arena.getTypeTag(), typeTag);
+
+    EXPECT_EQ(countMismatches(arenaList, heapList), 0);
+  }
+}
+
+TEST(dialArenaTest, MixedTypes)
+{
+  std::mt19937 rng(4321);
+
+  DialArena arena;
+  std::vector<DialBase*> arenaList{};
+  std::vector<std::unique_ptr<DialBase>> heapList{};
+  for( int iDial = 0 ; iDial < 10 ; iDial++ ){
+    for( auto typeTag : testDialFactory::getConcreteTypeTagList() ){
+      auto dial = testDialFactory::makeDial(typeTag, rng);
+      heapList.emplace_back( dial->clone() );
+      arenaList.emplace_back( arena.store(dial) );
+      ASSERT_NE(arenaList.back(), nullptr);
+    }
+  }
+
+  EXPECT_EQ(arena.getTypeTag(), DialArena::TypeTag::Mixed);
+  EXPECT_EQ(countMismatches(arenaList, heapList), 0);
+}
+
+TEST(dialArenaTest, NormIsNotForeign)
+{
+  DialArena arena;
+  for( int iDial = 0 ; iDial < 10 ; iDial++ ){
+    std::unique_ptr<DialBase> dial = std::make_unique<Norm>();
+    EXPECT_NE(arena.store(dial), nullptr);
+  }
+  EXPECT_EQ(arena.getNbForeignDials(), 0);
+  EXPECT_EQ(arena.getTypeTag(), DialArena::TypeTag::Norm);
+}
+
+TEST(dialArenaTest, FloatBlocksArePacked)
+{
+  std::mt19937 rng(42);
+
+  DialArena arena;
+  std::vector<const FloatKnotSplineBase*> splineList{};
+  std::vector<const TabulatedDial*> tableList{};
+  for( int iDial = 0 ; iDial < 100 ; iDial++ ){
+    auto spline = testDialFactory::makeDial(DialArena::TypeTag::CompactSplineFloat, rng);
+    splineList.emplace_back( dynamic_cast<const FloatKnotSplineBase*>(arena.store(spline)) );
+    ASSERT_NE(splineList.back(), nullptr);
+
+    auto table = testDialFactory::makeDial(DialArena::TypeTag::Tabulated, rng);
+    tableList.emplace_back( dynamic_cast<const TabulatedDial*>(arena.store(table)) );
+    ASSERT_NE(tableList.back(), nullptr);
+  }
+
+  // the blocks of a pool follow each other, whatever the other pools do
+  long nGaps{0};
+  for( size_t iDial = 1 ; iDial < splineList.size() ; iDial++ ){
+    auto* previous = splineList[iDial-1];
+    if( splineList[iDial]->getKnotData() != previous->getKnotData() + previous->getKnotDataSize() ){ nGaps++; }
+    if( tableList[iDial]->getResponseTable() != tableList[iDial-1]->getResponseTable() + 64 ){ nGaps++; }
+  }
+  EXPECT_EQ(nGaps, 0);
+}
+
+TEST(dialArenaTest, CloneOutlivesArena)
+{
+  std::mt19937 rng(7);
+
+  std::vector<std::unique_ptr<DialBase>> cloneList{};
+  std::vector<std::unique_ptr<DialBase>> heapList{};
+  {
+    DialArena arena;
+    for( auto typeTag : {DialArena::TypeTag::CompactSplineFloat, DialArena::TypeTag::Tabulated} ){
+      auto dial = testDialFactory::makeDial(typeTag, rng);
+      heapList.emplace_back( dial->clone() );
+      cloneList.emplace_back( arena.store(dial)->clone() );
+    }
+  }
+
+  // the clones own a copy of their float blocks
+  std::vector<DialBase*> dialList{};
+  for( auto& clone : cloneList ){ dialList.emplace_back( clone.get() ); }
+  EXPECT_EQ(countMismatches(dialList, heapList), 0);
+}
@@ -0,0 +1,131 @@
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <unordered_set>
+
+#include "DialCollection.h"
+#include "CompactSpline.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+  // uniform knots on [-3, 3]: the shape index sets the knot values
+  std::unique_ptr<DialBase> makeSpline(size_t shape_, double shift_ = 0){
+    std::vector<double> xList{-3, -2, -1, 0, 1, 2, 3};
+    std::vector<double> yList(xList.size());
+    std::vector<double> slopeList(xList.size(), 0);
+    for( size_t iKnot = 0 ; iKnot < xList.size() ; iKnot++ ){
+      yList[iKnot] = 1 + 0.01 * double(shape_) * xList[iKnot];
+    }
+    yList[3] += shift_;
+
+    auto dial = std::make_unique<CompactSpline>();
+    dial->buildDial(xList, yList, slopeList);
+    return dial;
+  }
+
+  // a collection only used to store event-by-event dials
+  struct DeduplicatedCollection{
+    std::vector<ParameterSet> parSetList{};
+    DialCollection collection{&parSetList};
+
+    explicit DeduplicatedCollection(size_t nSlots_){
+      collection.setDeduplicateDials(true);
+      collection.getDialBaseList().resize(nSlots_);
+    }
+
+    // the slots are claimed in order: this is the number of dials kept
+    size_t getNbStoredDials(){ return collection.getNextDialFreeSlot(); }
+  };
+}
+
+TEST(dialDeduplicationTest, IdenticalKnotsShareOneDial)
+{
+  DeduplicatedCollection store(4);
+
+  size_t slot{store.collection.storeEventDial( makeSpline(3) )};
+  EXPECT_EQ(store.collection.storeEventDial( makeSpline(3) ), slot);
+  EXPECT_EQ(store.collection.storeEventDial( makeSpline(3) ), slot);
+  EXPECT_EQ(store.getNbStoredDials(), 1);
+
+  // the shared dial is the original one
+  EXPECT_EQ(store.collection.getDialBaseList()[slot]->getDialData(), makeSpline(3)->getDialData());
+}
+
+TEST(dialDeduplicationTest, NearIdenticalNotMerged)
+{
+  DeduplicatedCollection store(8);
+
+  size_t slot{store.collection.storeEventDial( makeSpline(3) )};
+
+  // a single knot differing by one ulp
+  double y{1};
+  double shift{std::nextafter(y, 2.) - y};
+  EXPECT_NE(store.collection.storeEventDial( makeSpline(3, shift) ), slot);
+
+  // same knots but extrapolated
+  auto extrapolated = makeSpline(3);
+  extrapolated->setAllowExtrapolation(true);
+  EXPECT_NE(store.collection.storeEventDial( std::move(extrapolated) ), slot);
+
+  // another shape
+  EXPECT_NE(store.collection.storeEventDial( makeSpline(4) ), slot);
+
+  EXPECT_EQ(store.getNbStoredDials(), 4);
+}
+
+TEST(dialDeduplicationTest, DeduplicationRate)
+{
+  const size_t nDials{1000};
+  const size_t nShapes{37};
+  DeduplicatedCollection store(nDials);
+
+  std::unordered_set<size_t> slotSet{};
+  for( size_t iDial = 0 ; iDial < nDials ; iDial++ ){
+    size_t slot{store.collection.storeEventDial( makeSpline(iDial % nShapes) )};
+    slotSet.insert(slot);
+    EXPECT_EQ(store.collection.getDialBaseList()[slot]->getDialData(), makeSpline(iDial % nShapes)->getDialData());
+  }
+
+  // (nDials - nShapes)/nDials of the dials are duplicates
+  EXPECT_EQ(slotSet.size(), nShapes);
+  EXPECT_EQ(store.getNbStoredDials(), nShapes);
+}
+
+TEST(dialDeduplicationTest, ConcurrentInsert)
+{
+  // enough shapes to hit all of the shards
+  const size_t nShapes{500};
+  const int nThreads{8};
+  DeduplicatedCollection store(nShapes * nThreads);
+
+  // every thread stores all of the shapes in its own order
+  std::vector<std::vector<size_t>> slotList(nThreads, std::vector<size_t>(nShapes));
+  std::vector<std::thread> threadList;
+  for( int iThread = 0 ; iThread < nThreads ; iThread++ ){
+    threadList.emplace_back([&, iThread]{
+      std::vector<size_t> shapeList(nShapes);
+      for( size_t iShape = 0 ; iShape < nShapes ; iShape++ ){ shapeList[iShape] = iShape; }
+      std::shuffle(shapeList.begin(), shapeList.end(), std::mt19937(iThread));
+      for( auto iShape : shapeList ){
+        slotList[iThread][iShape] = store.collection.storeEventDial( makeSpline(iShape) );
+      }
+    });
+  }
+  for( auto& thread : threadList ){ thread.join(); }
+
+  // each shape is stored once and all the threads got its slot
+  long nMismatches{0};
+  for( size_t iShape = 0 ; iShape < nShapes ; iShape++ ){
+    for( int iThread = 1 ; iThread < nThreads ; iThread++ ){
+      if( slotList[iThread][iShape] != slotList[0][iShape] ){ nMismatches++; }
+    }
+    auto& dial = store.collection.getDialBaseList()[slotList[0][iShape]];
+    if( dial == nullptr or dial->getDialData() != makeSpline(iShape)->getDialData() ){ nMismatches++; }
+  }
+  EXPECT_EQ(nMismatches, 0);
+  EXPECT_EQ(store.getNbStoredDials(), nShapes);
+}
@@ -0,0 +1,126 @@
+#include <vector>
+#include <memory>
+#include <random>
+
+#include "EventDialCache.h"
+#include "DialInterface.h"
+#include "DialInputBuffer.h"
+#include "DialResponseSupervisor.h"
+
+#include "testDialFactory.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+  // dials of the given type (one of each concrete type for Mixed) spread
+  // over a few input buffers, one of them being masked
+  struct DialRange{
+    std::vector<std::unique_ptr<DialBase>> dialList{};
+    std::vector<DialInputBuffer> inputList{};
+    std::vector<DialInterface> interfaceList{};
+    std::vector<DialInterface*> interfacePtrList{};
+    DialResponseSupervisor supervisor{};
+
+    DialRange(DialArena::TypeTag typeTag_, size_t nDials_, std::mt19937& rng_){
+      auto typeTagList = testDialFactory::getConcreteTypeTagList();
+      for( size_t iDial = 0 ; iDial < nDials_ ; iDial++ ){
+        auto typeTag = typeTag_;
+        if( typeTag == DialArena::TypeTag::Mixed ){ typeTag = typeTagList[iDial % typeTagList.size()]; }
+        dialList.emplace_back( testDialFactory::makeDial(typeTag, rng_) );
+      }
+
+      inputList.resize(4);
+      for( auto& input : inputList ){ input.getInputBuffer().resize(1); }
+      inputList.back().setIsMasked(true);
+
+      // the clamping is part of the table entries
+      supervisor.setMinResponse(0);
+      supervisor.setMaxResponse(1.4);
+
+      interfaceList.resize( dialList.size() );
+      for( size_t iDial = 0 ; iDial < dialList.size() ; iDial++ ){
+        interfaceList[iDial].setDialBaseRef( dialList[iDial].get() );
+        interfaceList[iDial].setInputBufferRef( &inputList[iDial % inputList.size()] );
+        interfaceList[iDial].setResponseSupervisorRef( &supervisor );
+        interfacePtrList.emplace_back( &interfaceList[iDial] );
+      }
+    }
+
+    void setInput(double x_){ for( auto& input : inputList ){ input.setInputValue(0, x_); } }
+
+    // evaluates the table entries with the typed loop, and compares them to the virtual call
+    template<typename R> long countMismatches(DialArena::TypeTag typeTag_, const char* isBatchedList_ = nullptr){
+      std::vector<R> table(interfacePtrList.size(), R(-1));
+      EventDialCache::evalDialRange(typeTag_, interfacePtrList.data(), isBatchedList_, table.data(), 0, int(table.size()));
+
+      long nMismatches{0};
+      for( size_t iDial = 0 ; iDial < table.size() ; iDial++ ){
+        // the batched entries are left to the spline kernels
+        R expected{ (isBatchedList_ != nullptr and isBatchedList_[iDial]) ? R(-1) : R(interfaceList[iDial].evalResponse()) };
+        if( table[iDial] != expected ){ nMismatches++; }
+      }
+      return nMismatches;
+    }
+  };
+
+  std::vector<DialArena::TypeTag> getTypeTagList(){
+    auto out = testDialFactory::getConcreteTypeTagList();
+    out.emplace_back( DialArena::TypeTag::Mixed );
+    return out;
+  }
+}
+
+TEST(dialDispatchTest, TypedMatchesVirtual)
+{
+  std::mt19937 rng(2024);
+
+  for( auto typeTag : getTypeTagList() ){
+    SCOPED_TRACE( DialArena::getTypeTagName(typeTag) );
+    DialRange range(typeTag, 200, rng);
+
+    long nMismatches{0};
+    long nMismatchesFloat{0};
+    for( double x = -4 ; x <= 4 ; x += 0.05 ){
+      range.setInput(x);
+      nMismatches += range.countMismatches<double>(typeTag);
+      nMismatchesFloat += range.countMismatches<float>(typeTag);
+    }
+    EXPECT_EQ(nMismatches, 0);
+    EXPECT_EQ(nMismatchesFloat, 0);
+  }
+}
+
+TEST(dialDispatchTest, FallbackMatchesVirtual)
+{
+  std::mt19937 rng(2025);
+
+  // a collection whose type isn't resolved goes through the virtual call
+  for( auto typeTag : testDialFactory::getConcreteTypeTagList() ){
+    SCOPED_TRACE( DialArena::getTypeTagName(typeTag) );
+    DialRange range(typeTag, 50, rng);
+
+    long nMismatches{0};
+    for( double x = -4 ; x <= 4 ; x += 0.25 ){
+      range.setInput(x);
+      nMismatches += range.countMismatches<double>(DialArena::TypeTag::Mixed);
+      nMismatches += range.countMismatches<double>(DialArena::TypeTag::Unknown);
+    }
+    EXPECT_EQ(nMismatches, 0);
+  }
+}
+
+TEST(dialDispatchTest, BatchedEntriesSkipped)
+{
+  std::mt19937 rng(2026);
+
+  for( auto typeTag : getTypeTagList() ){
+    SCOPED_TRACE( DialArena::getTypeTagName(typeTag) );
+    DialRange range(typeTag, 60, rng);
+
+    std::vector<char> isBatchedList(range.interfacePtrList.size(), false);
+    for( size_t iDial = 0 ; iDial < isBatchedList.size() ; iDial += 3 ){ isBatchedList[iDial] = true; }
+
+    range.setInput(0.7);
+    EXPECT_EQ(range.countMismatches<double>(typeTag, isBatchedList.data()), 0);
+  }
+}
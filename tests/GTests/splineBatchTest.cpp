@@ -0,0 +1,112 @@
+#include <random>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+#include "CalculateSplineBatch.h"
+#include "CalculateCompactSpline.h"
+#include "CalculateMonotonicSpline.h"
+#include "CalculateUniformSpline.h"
+#include "CalculateGeneralSpline.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+  // random splines with nKnots_ knots starting around -3, in the data layout
+  // of the scalar functions
+  std::vector<std::vector<double>> makeSplines(SplineBatch::Type type_, int nKnots_, size_t nSplines_){
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> uniform(0.5, 1.5);
+
+    std::vector<std::vector<double>> out(nSplines_);
+    for( auto& data : out ){
+      double low{-3 + 0.1*uniform(rng)};
+      double step{uniform(rng)};
+      data = {low, step};
+      for( int iKnot = 0 ; iKnot < nKnots_ ; iKnot++ ){
+        data.emplace_back( uniform(rng) );
+        if( type_ == SplineBatch::Type::Uniform or type_ == SplineBatch::Type::General ){ data.emplace_back( uniform(rng) - 1 ); }
+        if( type_ == SplineBatch::Type::General ){ data.emplace_back( low + iKnot*step + 0.2*step*(uniform(rng) - 1) ); }
+      }
+    }
+    return out;
+  }
+
+  double evalScalar(SplineBatch::Type type_, double x_, const std::vector<double>& data_){
+    switch( type_ ){
+      case SplineBatch::Type::Compact: return CalculateCompactSpline(x_, -1E20, 1E20, data_.data(), int(data_.size()-2));
+      case SplineBatch::Type::Monotonic: return CalculateMonotonicSpline(x_, -1E20, 1E20, data_.data(), int(data_.size()-2));
+      case SplineBatch::Type::Uniform: return CalculateUniformSpline(x_, -1E20, 1E20, data_.data(), int(data_.size()));
+      case SplineBatch::Type::General: return CalculateGeneralSpline(x_, -1E20, 1E20, data_.data(), int(data_.size()));
+    }
+    return 0;
+  }
+
+  // returns the number of responses differing from the scalar functions
+  long countMismatches(SplineBatch::Type type_){
+    const int nKnots{7};
+    const size_t nSplines{1000};
+    auto splineList = makeSplines(type_, nKnots, nSplines);
+
+    // half of the splines are not extrapolated
+    SplineBatch::Group group;
+    group.type = type_;
+    group.nKnots = nKnots;
+    std::vector<std::pair<double, double>> boundList;
+    for( size_t iSpline = 0 ; iSpline < nSplines ; iSpline++ ){
+      auto& data = splineList[iSpline];
+      if( iSpline % 2 ){ boundList.emplace_back( -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity() ); }
+      else{ boundList.emplace_back( data[0], data[0] + (nKnots-1)*data[1] ); }
+      group.addSpline( data, boundList.back().first, boundList.back().second );
+    }
+    group.finalize();
+
+    long nMismatches{0};
+    std::vector<double> responseList(nSplines);
+    // small steps: the cached knot interval is reused most of the time
+    for( double x = -5 ; x < 5 ; x += 0.0173 ){
+      SplineBatch::evalGroup( group, x, responseList.data(), 0, nSplines );
+      for( size_t iSpline = 0 ; iSpline < nSplines ; iSpline++ ){
+        double xClamped{x};
+        if     ( xClamped <= boundList[iSpline].first ){ xClamped = boundList[iSpline].first; }
+        else if( xClamped >= boundList[iSpline].second ){ xClamped = boundList[iSpline].second; }
+        if( responseList[iSpline] != evalScalar(type_, xClamped, splineList[iSpline]) ){ nMismatches++; }
+      }
+    }
+    return nMismatches;
+  }
+
+  // single precision knots: same result as the double precision function
+  // fed with the rounded knots, and close to the exact one
+  void checkFloatKnots(SplineBatch::Type type_){
+    auto splineList = makeSplines(type_, 7, 100);
+    for( auto& data : splineList ){
+      std::vector<float> floatData(data.begin(), data.end());
+      std::vector<double> roundedData(floatData.begin(), floatData.end());
+      for( double x = -4 ; x < 4 ; x += 0.0173 ){
+        double floatResponse{};
+        switch( type_ ){
+          case SplineBatch::Type::Compact: floatResponse = CalculateCompactSpline(x, -1E20, 1E20, floatData.data(), int(floatData.size()-2)); break;
+          case SplineBatch::Type::Monotonic: floatResponse = CalculateMonotonicSpline(x, -1E20, 1E20, floatData.data(), int(floatData.size()-2)); break;
+          case SplineBatch::Type::Uniform: floatResponse = CalculateUniformSpline(x, -1E20, 1E20, floatData.data(), int(floatData.size())); break;
+          case SplineBatch::Type::General: floatResponse = CalculateGeneralSpline(x, -1E20, 1E20, floatData.data(), int(floatData.size())); break;
+        }
+        EXPECT_EQ(floatResponse, evalScalar(type_, x, roundedData));
+        double exactResponse{evalScalar(type_, x, data)};
+        EXPECT_NEAR(floatResponse, exactResponse, 1E-5 * std::max(1., std::abs(exactResponse)));
+      }
+    }
+  }
+}
+
+TEST(SplineBatch, CompactMatchesScalar){ EXPECT_EQ(countMismatches(SplineBatch::Type::Compact), 0); }
+TEST(SplineBatch, MonotonicMatchesScalar){ EXPECT_EQ(countMismatches(SplineBatch::Type::Monotonic), 0); }
+TEST(SplineBatch, UniformMatchesScalar){ EXPECT_EQ(countMismatches(SplineBatch::Type::Uniform), 0); }
+TEST(SplineBatch, GeneralMatchesScalar){ EXPECT_EQ(countMismatches(SplineBatch::Type::General), 0); }
+
+TEST(SplineFloatKnots, Compact){ checkFloatKnots(SplineBatch::Type::Compact); }
+TEST(SplineFloatKnots, Monotonic){ checkFloatKnots(SplineBatch::Type::Monotonic); }
+TEST(SplineFloatKnots, Uniform){ checkFloatKnots(SplineBatch::Type::Uniform); }
+TEST(SplineFloatKnots, General){ checkFloatKnots(SplineBatch::Type::General); }
@@ -0,0 +1,68 @@
+#include <cmath>
+#include <limits>
+
+#include "DialBase.h"
+#include "DialInputBuffer.h"
+#include "TabulatedDial.h"
+
+#include "gtest/gtest.h"
+
+// smooth response with some curvature, flat beyond [-3, 3] like a clamped spline
+class QuadraticDial : public DialBase {
+public:
+  [[nodiscard]] std::unique_ptr<DialBase> clone() const override { return std::make_unique<QuadraticDial>(*this); }
+  [[nodiscard]] std::string getDialTypeName() const override { return {"QuadraticDial"}; }
+  [[nodiscard]] double evalResponse(const DialInputBuffer& input_) const override {
+    double x{std::min(3., std::max(-3., input_.getInputBuffer()[0]))};
+    return 1 + 0.1*x + 0.05*x*x;
+  }
+};
+
+namespace {
+  double eval(const DialBase& dial_, double x_){
+    DialInputBuffer input{};
+    input.getInputBuffer().resize(1);
+    input.getInputBuffer()[0] = x_;
+    return dial_.evalResponse(input);
+  }
+}
+
+TEST(tabulatedDialTest, MatchesOriginal)
+{
+  QuadraticDial dial;
+  double maxDeviation{-1};
+  auto tabulated = TabulatedDial::makeTabulatedDial(dial, {-3, 3}, 128, maxDeviation);
+  ASSERT_NE(tabulated, nullptr);
+
+  // linear interpolation error of a parabola: 0.05 * step^2 / 4
+  double step{6./127};
+  EXPECT_NEAR(maxDeviation, 0.05*step*step/4, 1E-6);
+
+  double observedMax{0};
+  for( double x = -3 ; x <= 3 ; x += 0.001 ){
+    observedMax = std::max(observedMax, std::abs(eval(*tabulated, x) - eval(dial, x)));
+  }
+  EXPECT_LE(observedMax, maxDeviation + 1E-6);
+}
+
+TEST(tabulatedDialTest, FlatOutOfRange)
+{
+  QuadraticDial dial;
+  double maxDeviation;
+  auto tabulated = TabulatedDial::makeTabulatedDial(dial, {-3, 3}, 64, maxDeviation);
+  ASSERT_NE(tabulated, nullptr);
+  EXPECT_FLOAT_EQ(eval(*tabulated, -10), eval(dial, -3));
+  EXPECT_FLOAT_EQ(eval(*tabulated, 10), eval(dial, 3));
+  EXPECT_FLOAT_EQ(eval(*tabulated, std::nan("")), eval(dial, -3));
+
+  auto copy = tabulated->clone();
+  EXPECT_EQ(eval(*copy, 1.234), eval(*tabulated, 1.234));
+}
+
+TEST(tabulatedDialTest, UnboundedRange)
+{
+  QuadraticDial dial;
+  double maxDeviation;
+  EXPECT_EQ(TabulatedDial::makeTabulatedDial(dial, {std::nan("unset"), 3}, 64, maxDeviation), nullptr);
+  EXPECT_EQ(TabulatedDial::makeTabulatedDial(dial, {-3, std::numeric_limits<double>::infinity()}, 64, maxDeviation), nullptr);
+}
@@ -0,0 +1,99 @@
+#ifndef GUNDAM_TEST_DIAL_FACTORY_H
+#define GUNDAM_TEST_DIAL_FACTORY_H
+
+// Dials of every concrete type described by a DialArena::TypeTag, with
+// random knots. Shared by the dial storage and evaluation unit tests.
+
+#include "DialArena.h"
+#include "Shift.h"
+#include "Norm.h"
+#include "LightGraph.h"
+#include "CompactSpline.h"
+#include "MonotonicSpline.h"
+#include "UniformSpline.h"
+#include "GeneralSpline.h"
+#include "FloatKnotSpline.h"
+#include "TabulatedDial.h"
+
+#include "TGraph.h"
+
+#include <random>
+#include <memory>
+#include <vector>
+
+namespace testDialFactory {
+
+  // knots every unit over [-3, 3]
+  template<typename T> std::unique_ptr<DialBase> makeSpline(std::mt19937& rng_){
+    std::uniform_real_distribution<double> uniform(0.5, 1.5);
+    std::vector<double> xList{-3, -2, -1, 0, 1, 2, 3};
+    std::vector<double> yList{};
+    std::vector<double> slopeList{};
+    for( size_t iKnot = 0 ; iKnot < xList.size() ; iKnot++ ){
+      yList.emplace_back( uniform(rng_) );
+      slopeList.emplace_back( uniform(rng_) - 1 );
+    }
+    auto dial = std::make_unique<T>();
+    dial->buildDial(xList, yList, slopeList);
+    return dial;
+  }
+
+  template<typename T> std::unique_ptr<DialBase> makeGraph(std::mt19937& rng_){
+    std::uniform_real_distribution<double> uniform(0.5, 1.5);
+    TGraph graph{};
+    for( int iPoint = 0 ; iPoint < 7 ; iPoint++ ){ graph.SetPoint(iPoint, iPoint - 3, uniform(rng_)); }
+    auto dial = std::make_unique<T>();
+    dial->buildDial(graph);
+    return dial;
+  }
+
+  template<typename T> std::unique_ptr<DialBase> makeFloatSpline(std::mt19937& rng_){
+    return FloatKnotSplineBase::makeFloatKnotSpline( *makeSpline<T>(rng_) );
+  }
+
+  inline std::unique_ptr<DialBase> makeTabulated(std::mt19937& rng_){
+    double maxDeviation{0};
+    return TabulatedDial::makeTabulatedDial( *makeSpline<CompactSpline>(rng_), {-3, 3}, 64, maxDeviation );
+  }
+
+  /// nullptr for Unknown and Mixed
+  inline std::unique_ptr<DialBase> makeDial(DialArena::TypeTag typeTag_, std::mt19937& rng_){
+    using TypeTag = DialArena::TypeTag;
+    switch( typeTag_ ){
+      case TypeTag::Shift:{
+        auto dial = std::make_unique<Shift>();
+        dial->buildDial( std::uniform_real_distribution<double>(0.5, 1.5)(rng_) );
+        return dial;
+      }
+      case TypeTag::Norm: return std::make_unique<Norm>();
+      case TypeTag::LightGraph: return makeGraph<LightGraph>(rng_);
+      case TypeTag::LightGraphCache: return makeGraph<LightGraphCache>(rng_);
+      case TypeTag::CompactSpline: return makeSpline<CompactSpline>(rng_);
+      case TypeTag::CompactSplineCache: return makeSpline<CompactSplineCache>(rng_);
+      case TypeTag::MonotonicSpline: return makeSpline<MonotonicSpline>(rng_);
+      case TypeTag::MonotonicSplineCache: return makeSpline<MonotonicSplineCache>(rng_);
+      case TypeTag::UniformSpline: return makeSpline<UniformSpline>(rng_);
+      case TypeTag::UniformSplineCache: return makeSpline<UniformSplineCache>(rng_);
+      case TypeTag::GeneralSpline: return makeSpline<GeneralSpline>(rng_);
+      case TypeTag::GeneralSplineCache: return makeSpline<GeneralSplineCache>(rng_);
+      case TypeTag::CompactSplineFloat: return makeFloatSpline<CompactSpline>(rng_);
+      case TypeTag::MonotonicSplineFloat: return makeFloatSpline<MonotonicSpline>(rng_);
+      case TypeTag::UniformSplineFloat: return makeFloatSpline<UniformSpline>(rng_);
+      case TypeTag::GeneralSplineFloat: return makeFloatSpline<GeneralSpline>(rng_);
+      case TypeTag::Tabulated: return makeTabulated(rng_);
+      default: return nullptr;
+    }
+  }
+
+  /// Every tag with a concrete type
+  inline std::vector<DialArena::TypeTag> getConcreteTypeTagList(){
+    std::vector<DialArena::TypeTag> out{};
+    for( int iTag = int(DialArena::TypeTag::Unknown) + 1 ; iTag < int(DialArena::TypeTag::Mixed) ; iTag++ ){
+      out.emplace_back( DialArena::TypeTag(iTag) );
+    }
+    return out;
+  }
+
+}
+
+#endif //GUNDAM_TEST_DIAL_FACTORY_H
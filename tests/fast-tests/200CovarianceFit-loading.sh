@@ -0,0 +1,52 @@
+#!/bin/bash
+#
+# Load 200CovarianceFit-config.yaml with the different loading modes.  The
+# single pass and pipelined loadings are fitted like 200CovarianceFit.sh.
+# The rejected events configuration is only loaded, with one and with four
+# threads.  The outputs are compared by 900CovarianceFitCheck-loading.C.
+
+# Set the base name for this test (should match the script name)
+BASE=200CovarianceFit
+
+# Get the directory containing the script from the command line
+# parameters (avoids bash trickery).  Use the current directory as the
+# default.
+DIR=.
+if [ ${#1} -gt 0 ]; then
+    DIR=${1}
+fi
+
+# Make sure that gundam has been setup.
+if ! which gundamFitter; then
+    echo FAIL: Executable not found for gundamFitter
+    exit 1
+fi
+
+# Set the expected locations for the config and output files.
+export CONFIG_DIR=${DIR}
+export DATA_DIR=${PWD}
+
+CONFIG_FILE=${CONFIG_DIR}/${BASE}-config.yaml
+
+echo ${CONFIG_FILE}
+
+# runLoading <mode> <output suffix> <gundamFitter options>
+runLoading() {
+    local OVERRIDE_FILE=${CONFIG_DIR}/${BASE}-${1}.yaml
+    local OUTPUT_FILE=${DATA_DIR}/${BASE}-${1}${2}.root
+    shift 2
+    echo ${OVERRIDE_FILE}
+    echo ${OUTPUT_FILE}
+    if ! gundamFitter --cpu -c ${CONFIG_FILE} -of ${OVERRIDE_FILE} \
+         -o ${OUTPUT_FILE} "$@"; then
+        echo FAIL: gundamFitter failed for ${OUTPUT_FILE}
+        exit 1
+    fi
+}
+
+runLoading singlePass "" -t 4 -s 10000
+runLoading pipelined "" -t 4 -s 10000
+runLoading rejected -reference -t 1 -d
+runLoading rejected "" -t 4 -d
+
+# End of the script
@@ -0,0 +1,52 @@
+#!/bin/bash
+#
+# Check that an error raised while loading with the pipelined mode of
+# 200CovarianceFit-pipelined.yaml (applied on top of
+# 200CovarianceFit-config.yaml) stops all of the loading threads.  The
+# negative nominal weights make a reader thread throw: gundamFitter must
+# exit with an error instead of waiting forever on the pipeline.
+
+# Set the base name for this test (should match the script name)
+BASE=200CovarianceFit-pipelined
+
+# Get the directory containing the script from the command line
+# parameters (avoids bash trickery).  Use the current directory as the
+# default.
+DIR=.
+if [ ${#1} -gt 0 ]; then
+    DIR=${1}
+fi
+
+# Make sure that gundam has been setup.
+if ! which gundamFitter; then
+    echo FAIL: Executable not found for gundamFitter
+    exit 1
+fi
+
+# Set the expected locations for the config and output files.
+export CONFIG_DIR=${DIR}
+export DATA_DIR=${PWD}
+
+CONFIG_FILE=${CONFIG_DIR}/200CovarianceFit-config.yaml
+OVERRIDE_FILE=${CONFIG_DIR}/${BASE}.yaml
+OUTPUT_FILE=${DATA_DIR}/${BASE}Abort.root
+
+echo ${OUTPUT_FILE}
+echo ${CONFIG_FILE}
+echo ${OVERRIDE_FILE}
+
+timeout 300 gundamFitter --cpu -t 4 -d -c ${CONFIG_FILE} -of ${OVERRIDE_FILE} -o ${OUTPUT_FILE} \
+    -O "/fitterEngineConfig/propagatorConfig/dataSetList/0/mc/nominalWeightFormula=(C > 0) - 0.5"
+STATUS=$?
+
+if [ ${STATUS} -eq 124 ]; then
+    echo FAIL: gundamFitter did not stop after the loading error
+    exit 1
+fi
+if [ ${STATUS} -eq 0 ]; then
+    echo FAIL: gundamFitter did not report the loading error
+    exit 1
+fi
+echo SUCCESS: gundamFitter stopped with status ${STATUS}
+
+# End of the script
@@ -0,0 +1,53 @@
+#!/bin/bash
+#
+# Scan the parameters of 200CovarianceFit-config.yaml with one propagation
+# per point, and with the batched evaluation for several batch sizes.  The
+# scans are compared by 900CovarianceFitCheck-scan.C.
+
+# Set the base name for this test (should match the script name)
+BASE=200CovarianceFit-scan
+
+# Get the directory containing the script from the command line
+# parameters (avoids bash trickery).  Use the current directory as the
+# default.
+DIR=.
+if [ ${#1} -gt 0 ]; then
+    DIR=${1}
+fi
+
+# Make sure that gundam has been setup.
+if ! which gundamFitter; then
+    echo FAIL: Executable not found for gundamFitter
+    exit 1
+fi
+
+# Set the expected locations for the config and output files.
+export CONFIG_DIR=${DIR}
+export DATA_DIR=${PWD}
+
+CONFIG_FILE=${CONFIG_DIR}/200CovarianceFit-config.yaml
+OVERRIDE_FILE=${CONFIG_DIR}/${BASE}.yaml
+
+echo ${CONFIG_FILE}
+echo ${OVERRIDE_FILE}
+
+# 11 points per parameter
+runScan() {
+    local OUTPUT_FILE=${DATA_DIR}/${BASE}-${1}.root
+    shift
+    echo ${OUTPUT_FILE}
+    if ! gundamFitter --cpu -t 4 -d --scan 10 -c ${CONFIG_FILE} -of ${OVERRIDE_FILE} \
+         -o ${OUTPUT_FILE} "$@"; then
+        echo FAIL: parameter scan failed for ${OUTPUT_FILE}
+        exit 1
+    fi
+}
+
+runScan sequential
+for K in 1 4 11; do
+    runScan batch${K} \
+        -O "/fitterEngineConfig/scanConfig/useBatchEvaluation=true" \
+           "/fitterEngineConfig/scanConfig/batchEvaluationSize=${K}"
+done
+
+# End of the script
@@ -0,0 +1,50 @@
+#!/bin/bash
+#
+# Check the PropagatorWorker against its propagator (see
+# 200CovarianceFit-worker.yaml) with both event dial cache layouts, and
+# with eigen decomposed parameters.
+
+# Set the base name for this test (should match the script name)
+BASE=200CovarianceFit-worker
+
+# Get the directory containing the script from the command line
+# parameters (avoids bash trickery).  Use the current directory as the
+# default.
+DIR=.
+if [ ${#1} -gt 0 ]; then
+    DIR=${1}
+fi
+
+# Make sure that gundam has been setup.
+if ! which gundamFitter; then
+    echo FAIL: Executable not found for gundamFitter
+    exit 1
+fi
+
+# Set the expected locations for the config and output files.
+export CONFIG_DIR=${DIR}
+export DATA_DIR=${PWD}
+
+OVERRIDE_FILE=${CONFIG_DIR}/${BASE}.yaml
+
+echo ${OVERRIDE_FILE}
+
+runCheck() {
+    local NAME=${1}
+    local CONFIG_FILE=${2}
+    shift 2
+    if ! gundamFitter --cpu -t 4 -d -c ${CONFIG_FILE} -of ${OVERRIDE_FILE} \
+         -o ${DATA_DIR}/${BASE}-${NAME}.root "$@"; then
+        echo FAIL: PropagatorWorker check failed for ${NAME}
+        exit 1
+    fi
+}
+
+runCheck cache ${CONFIG_DIR}/200CovarianceFit-config.yaml
+runCheck compressed ${CONFIG_DIR}/200CovarianceFit-config.yaml \
+         -O "/fitterEngineConfig/propagatorConfig/useCompressedDialCache=true"
+runCheck eigen ${CONFIG_DIR}/200DecompositionFit-config.yaml
+
+echo SUCCESS: PropagatorWorker matches its propagator
+
+# End of the script